@@ -19,9 +19,12 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cmath>
+#include <algorithm>
 
 #include "lib/HLSVar.hpp"
 #include "test_comp.hpp"
+#include "CycleModel.hpp"
 
 BOOST_AUTO_TEST_SUITE(HLSVar_test)
 
@@ -259,6 +262,106 @@ BOOST_AUTO_TEST_CASE(moving_average_div_operator)
 	moving_avg(0); moving_avg(0);moving_avg(0); //TODO: flush the stream
 }
 
+BOOST_AUTO_TEST_CASE(recursive_long_window_mean_and_variance)
+{
+	constexpr int SIZE = 2000;
+	std::vector<uint10> stream_in(SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		stream_in[i] = (i*37 + (i*i)%101) % 1024;
+	}
+	for (int i=0; i<SIZE; ++i) {
+		Token<uint10> avg = moving_avg_long(stream_in[i]);
+		Token<uint20> variance = moving_variance_long(stream_in[i]);
+		BOOST_REQUIRE_EQUAL(avg.valid,i>=255);
+		BOOST_REQUIRE_EQUAL(variance.valid,i>=99);
+		if (avg.valid) {
+			long long sum {0};
+			for (int k=i-255; k<=i; ++k) { sum += stream_in[k]; }
+			BOOST_REQUIRE_EQUAL(avg.value,sum/256);
+		}
+		if (variance.valid) {
+			long long sum {0};
+			long long sum_of_squares {0};
+			for (int k=i-99; k<=i; ++k) { sum += stream_in[k]; sum_of_squares += stream_in[k]*stream_in[k]; }
+			BOOST_REQUIRE_EQUAL(variance.value,(sum_of_squares*100 - sum*sum)/10000);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(recursive_float_window_without_drift)
+{
+	constexpr int SIZE = 20000;
+	constexpr int N = 64;
+	std::vector<float> stream_in(SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		stream_in[i] = (i < SIZE-N) ? 1000.0f*std::sin(0.37f*i) + 0.001f*i : 0.0f;
+	}
+	Token<fixp_40_16> avg;
+	for (int i=0; i<SIZE; ++i) {
+		avg = moving_avg_float_long(stream_in[i]);
+		if (i>=N-1 && i%97==0) {
+			double sum {0.0};
+			for (int k=i-N+1; k<=i; ++k) { sum += fixp_40_16(stream_in[k]).to_double(); }
+			BOOST_REQUIRE_SMALL(avg.value.to_double() - sum/N,1e-4);
+		}
+	}
+	BOOST_REQUIRE(avg.valid);
+	BOOST_REQUIRE_EQUAL(avg.value.to_double(),0.0); // exactly zero after a window of zeros
+}
+
+BOOST_AUTO_TEST_CASE(fixed_point_variance_of_zero_window)
+{
+	constexpr int SIZE = 200000;
+	constexpr int N = 8;
+	MovingWindow<float,N,fixp_40_16,true> window;
+	for (int i=0; i<SIZE; ++i) {
+		window = (i < SIZE-N) ? 100.0f*std::sin(0.37f*i) + 0.013f*(i%101) : 0.0f;
+	}
+	BOOST_REQUIRE(window.variance().valid);
+	BOOST_REQUIRE_EQUAL(window.sum().value.to_double(),0.0);
+	BOOST_REQUIRE_EQUAL(window.variance().value.to_double(),0.0); // squares added and subtracted alike
+}
+
+BOOST_AUTO_TEST_CASE(cascaded_moving_sum)
+{
+	constexpr int SIZE = 500;
+	constexpr int N = 16;
+	std::vector<long long> stage[4];
+	stage[0].resize(SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		stage[0][i] = (i*53) % 1024;
+	}
+	for (int s=1; s<4; ++s) { // golden boxcar sums over the valid outputs of the previous stage
+		for (int i=N-1; i<stage[s-1].size(); ++i) {
+			long long sum {0};
+			for (int k=i-N+1; k<=i; ++k) { sum += stage[s-1][k]; }
+			stage[s].push_back(sum);
+		}
+	}
+	int out_count {0};
+	for (int i=0; i<SIZE; ++i) {
+		Token<uint10> result = cic_smoother_adc(static_cast<uint10>(stage[0][i]));
+		if (result.valid) {
+			BOOST_REQUIRE_EQUAL(result.value,stage[3][out_count] >> 12);
+			++out_count;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(out_count,stage[3].size());
+
+	CascadedMovingSum<uint10,N,3,uint22> smoother; // invalid tokens between the samples
+	out_count = 0;
+	for (int i=0; i<SIZE; ++i) {
+		Token<uint22> result = (smoother = Token<uint10>(stage[0][i]));
+		if (result.valid) {
+			BOOST_REQUIRE_EQUAL(result.value,stage[3][out_count]);
+			++out_count;
+		}
+		result = (smoother = Token<uint10>{0,false});
+		BOOST_REQUIRE(!result.valid);
+	}
+	BOOST_REQUIRE_EQUAL(out_count,stage[3].size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(convol2D_test)
@@ -326,6 +429,123 @@ BOOST_AUTO_TEST_CASE(streaming_test)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(reorder_buffer_transpose_and_tiles)
+{
+	constexpr int FRAMES = 3;
+	std::vector<uint10> transposed;
+	for (int i=0; i<(FRAMES+1)*6*8; ++i) {
+		Token<uint10> result = transpose_6x8(static_cast<uint10>(i % 1024));
+		if (result.valid) { transposed.push_back(result.value); }
+	}
+	BOOST_REQUIRE(transposed.size() >= FRAMES*6*8);
+	for (int f=0; f<FRAMES; ++f) {
+		for (int r=0; r<8; ++r) {
+			for (int c=0; c<6; ++c) {
+				BOOST_REQUIRE_EQUAL(transposed[f*48 + r*6 + c],f*48 + c*8 + r);
+			}
+		}
+	}
+
+	std::vector<uint10> tiles;
+	for (int i=0; i<(FRAMES+1)*64; ++i) {
+		Token<uint10> tile = raster_to_tile_4x4(static_cast<uint10>(i % 1024));
+		if (tile.valid) { tiles.push_back(tile.value); }
+	}
+	BOOST_REQUIRE(tiles.size() >= FRAMES*64);
+	std::vector<uint10> raster;
+	for (int i=0; i<(FRAMES+1)*64; ++i) {
+		Token<uint10> back = tile_to_raster_4x4((i<FRAMES*64) ? tiles[i] : static_cast<uint10>(0));
+		if (back.valid) { raster.push_back(back.value); }
+	}
+	BOOST_REQUIRE(raster.size() >= FRAMES*64);
+	for (int i=0; i<FRAMES*64; ++i) {
+		int within = i % 16;
+		int tile = (i % 64) / 16;
+		int r = (tile / 2)*4 + within / 4;
+		int c = (tile % 2)*4 + within % 4;
+		BOOST_REQUIRE_EQUAL(tiles[i],(i/64)*64 + r*8 + c);
+	}
+	for (int i=0; i<FRAMES*64; ++i) {
+		BOOST_REQUIRE_EQUAL(raster[i],i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(reorder_buffer_non_power_of_two_tiles)
+{
+	constexpr int ROWS = 6;
+	constexpr int COLS = 9;
+	constexpr int TILE_ROWS = 2;
+	constexpr int TILE_COLS = 3;
+	constexpr int FRAMES = 2;
+	ReorderBuffer<int,ROWS,COLS,ReorderMode::raster_to_tile,TILE_ROWS,TILE_COLS> to_tiles;
+	ReorderBuffer<int,ROWS,COLS,ReorderMode::tile_to_raster,TILE_ROWS,TILE_COLS> to_raster;
+	std::vector<int> tiles;
+	std::vector<int> raster;
+	for (int i=0; i<(FRAMES+2)*ROWS*COLS; ++i) {
+		Token<int> tile = (to_tiles = Token<int>{i,i<FRAMES*ROWS*COLS});
+		if (tile.valid) { tiles.push_back(tile.value); }
+		Token<int> back = (to_raster = tile);
+		if (back.valid) { raster.push_back(back.value); }
+	}
+	BOOST_REQUIRE_EQUAL(tiles.size(),FRAMES*ROWS*COLS);
+	BOOST_REQUIRE_EQUAL(raster.size(),FRAMES*ROWS*COLS);
+	for (int i=0; i<FRAMES*ROWS*COLS; ++i) {
+		const int within = i % (TILE_ROWS*TILE_COLS);
+		const int tile = (i % (ROWS*COLS)) / (TILE_ROWS*TILE_COLS);
+		const int r = (tile / (COLS/TILE_COLS))*TILE_ROWS + within / TILE_COLS;
+		const int c = (tile % (COLS/TILE_COLS))*TILE_COLS + within % TILE_COLS;
+		BOOST_REQUIRE_EQUAL(tiles[i],(i/(ROWS*COLS))*ROWS*COLS + r*COLS + c);
+		BOOST_REQUIRE_EQUAL(raster[i],i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(separable_gaussian)
+{
+	constexpr int FRAMES = 2;
+	constexpr int ROWS = GAUSS_ROWS;
+	constexpr int COLS = GAUSS_COLS;
+	constexpr int kernel[5] {1,4,6,4,1};
+	std::vector<int> frames(FRAMES*ROWS*COLS);
+	for (int i=0; i<frames.size(); ++i) {
+		frames[i] = (i*97 + (i*i) % 31) % 1024;
+	}
+
+	std::vector<int> golden(frames.size());
+	for (int f=0; f<FRAMES; ++f) {
+		int * frame = &frames[f*ROWS*COLS];
+		std::vector<int> row_filtered(ROWS*COLS);
+		for (int r=0; r<ROWS; ++r) {
+			for (int c=0; c<COLS; ++c) {
+				int sum {0};
+				for (int k=-2; k<=2; ++k) {
+					sum += (c+k>=0 && c+k<COLS) ? kernel[k+2]*frame[r*COLS + c+k] : 0;
+				}
+				row_filtered[r*COLS + c] = sum >> 4;
+			}
+		}
+		for (int r=0; r<ROWS; ++r) {
+			for (int c=0; c<COLS; ++c) {
+				int sum {0};
+				for (int k=-2; k<=2; ++k) {
+					sum += (r+k>=0 && r+k<ROWS) ? kernel[k+2]*row_filtered[(r+k)*COLS + c] : 0;
+				}
+				golden[f*ROWS*COLS + r*COLS + c] = sum >> 4;
+			}
+		}
+	}
+
+	std::vector<int> result;
+	for (int i=0; result.size()<frames.size(); ++i) {
+		BOOST_REQUIRE(i < (FRAMES+3)*ROWS*COLS);
+		uint10 pixel = (i<frames.size()) ? static_cast<uint10>(frames[i]) : static_cast<uint10>(0); // flush with zero frames
+		Token<uint10> filtered = gaussian5x5_separable(pixel);
+		if (filtered.valid) { result.push_back(filtered.value); }
+	}
+	for (int i=0; i<frames.size(); ++i) {
+		BOOST_REQUIRE_EQUAL(golden[i],result[i]);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -484,6 +704,141 @@ BOOST_AUTO_TEST_CASE(triangular_seven_point_smooth_uint10)
 	test_data_file.close();
 }
 
+BOOST_AUTO_TEST_CASE(triangular_seven_point_smooth_block_processing)
+{
+	std::vector<uint10> test_data;
+	std::ifstream input_file("data/data.dat");
+	std::string data;
+	while(std::getline(input_file,data,','))
+	{
+		float val = std::stod(data);
+		test_data.push_back(static_cast<uint10>(val));
+	}
+	input_file.close();
+
+	std::vector<uint10> result (test_data.size(),0.0);
+	for (int i=0; i<test_data.size(); ++i) {
+		result[i] = triangular_smooth_stencil_adc(test_data[i]);
+	}
+
+	std::vector<uint10> block_result (test_data.size(),0.0);
+	static HLSBlock<uint14,3,-3,100> stream; // blocks of 100 samples, calls of 37 samples and the rest
+	stream.process_block(test_data.data(),block_result.data(),37,triangular_smooth_stencil{});
+	stream.process_block(test_data.data()+37,block_result.data()+37,test_data.size()-37,triangular_smooth_stencil{});
+
+	for (int i=0; i<result.size() ;++i) {
+		BOOST_REQUIRE_EQUAL(result[i],block_result[i]);
+	}
+}
+
+// stages of peak_finder_adc as stencils, one per HLSVar
+struct peak_smoothing_stencil {
+	template<typename W>
+	Token<uint14> operator()(const W & stream) const {
+		return (stream.offset(-3) + Token<uint14>(2)*stream.offset(-2) + Token<uint14>(3)*stream.offset(-1)
+				+ Token<uint14>(4)*stream.offset(0) + Token<uint14>(3)*stream.offset(+1)
+				+ Token<uint14>(2)*stream.offset(+2) + stream.offset(+3))/Token<uint14>(16);
+	}
+};
+
+struct peak_derivative_stencil {
+	template<typename W>
+	Token<int11> operator()(const W & stream) const {
+		Token<int11> derivative;
+		derivative = ( stream.offset(-1) - stream.offset(1) ) / Token<int2>(2);
+		return derivative;
+	}
+};
+
+struct identity_stencil {
+	template<typename W>
+	auto operator()(const W & stream) const {
+		return stream.offset(0);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(peak_finder_chained_block_processing)
+{
+	std::vector<uint10> test_data;
+	std::ifstream input_file("data/data.dat");
+	std::string data;
+	while(std::getline(input_file,data,','))
+	{
+		float val = std::stod(data);
+		test_data.push_back(static_cast<uint10>(val));
+	}
+	input_file.close();
+	const std::size_t n = test_data.size();
+
+	// per-invocation path of the cascade, from the reset state
+	HLSVar<uint14,3,-3> triangular_stream_buffer;
+	HLSVar<uint14,1,-1> smoothed_stream;
+	HLSVar<int11> derivative;
+	std::vector<Token<int11>> result (n);
+	for (std::size_t i=0; i<n; ++i) {
+		triangular_stream_buffer = test_data[i];
+		smoothed_stream = peak_smoothing_stencil{}(triangular_stream_buffer);
+		derivative = peak_derivative_stencil{}(smoothed_stream);
+		result[i] = derivative.offset(0);
+	}
+
+	// one HLSBlock per HLSVar, fed block to block in calls of 37 samples and the rest
+	std::vector<Token<uint10>> samples (n);
+	for (std::size_t i=0; i<n; ++i) {
+		samples[i] = Token<uint10>(test_data[i]);
+	}
+	static HLSBlock<uint14,3,-3,100> triangular_block;
+	static HLSBlock<uint14,1,-1,100> smoothed_block;
+	static HLSBlock<int11,0,0,100> derivative_block;
+	std::vector<Token<uint14>> smoothed (n);
+	std::vector<Token<int11>> differences (n);
+	std::vector<Token<int11>> block_result (n);
+	for (std::size_t begin=0; begin<n; begin+=37) {
+		const std::size_t count = (n-begin < 37) ? n-begin : 37;
+		triangular_block.process_block(samples.data()+begin,smoothed.data()+begin,count,peak_smoothing_stencil{});
+		smoothed_block.process_block(smoothed.data()+begin,differences.data()+begin,count,peak_derivative_stencil{});
+		derivative_block.process_block(differences.data()+begin,block_result.data()+begin,count,identity_stencil{});
+	}
+
+	for (std::size_t i=0; i<n; ++i) {
+		BOOST_REQUIRE_EQUAL(result[i].value,block_result[i].value);
+		BOOST_REQUIRE_EQUAL(result[i].valid,block_result[i].valid);
+	}
+	// the component itself, once its window holds only samples of this run
+	for (std::size_t i=0; i<n; ++i) {
+		const int11 component_result = peak_finder_adc(test_data[i]);
+		if (i >= 8) {
+			BOOST_REQUIRE_EQUAL(component_result,block_result[i].value);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(triangular_seven_point_smooth_folded)
+{
+	constexpr int FOLD = TRIANGULAR_FOLD;
+	constexpr int SIZE = 40;
+	constexpr int coefficients[7] {1,2,3,4,3,2,1};
+	std::vector<int> stream_in(SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		stream_in[i] = (i*151) % 1024;
+	}
+
+	int out_count {0};
+	for (int t=0; t<SIZE*FOLD; ++t) { // one valid sample every FOLD invocations
+		Token<uint10> sample = (t%FOLD == 0) ? Token<uint10>(stream_in[t/FOLD]) : Token<uint10>{0,false};
+		Token<uint14> result = triangular_smooth_folded(sample);
+		int i = t/FOLD;
+		BOOST_REQUIRE_EQUAL(result.valid,(t%FOLD == FOLD-1) && (i >= 6));
+		if (result.valid) {
+			int golden {0};
+			for (int k=0; k<7; ++k) { golden += coefficients[k]*stream_in[i-6+k]; }
+			BOOST_REQUIRE_EQUAL(result.value,golden);
+			++out_count;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(out_count,SIZE-6);
+}
+
 BOOST_AUTO_TEST_CASE(peak_finder_test)
 {
 	std::vector<uint10> test_data;
@@ -509,6 +864,68 @@ BOOST_AUTO_TEST_CASE(peak_finder_test)
 	output_file.close();
 }
 
+BOOST_AUTO_TEST_CASE(peak_finder_delay_line_test)
+{
+	std::vector<uint10> test_data;
+	std::ifstream input_file("data/data.dat");
+	std::string data;
+	while(std::getline(input_file,data,','))
+	{
+		float val = std::stod(data);
+		test_data.push_back(static_cast<uint10>(val));
+	}
+	input_file.close();
+
+	std::vector<int11> result (test_data.size(),0.0);
+	std::vector<int11> delay_line_result (test_data.size(),0.0);
+	for (int i=0; i<test_data.size(); ++i) {
+		ihc_hls_enqueue(&result[i],&peak_finder_adc,test_data[i]);
+		ihc_hls_enqueue(&delay_line_result[i],&peak_finder_delay_line_adc,test_data[i]);
+	}
+	ihc_hls_component_run_all(peak_finder_adc);
+	ihc_hls_component_run_all(peak_finder_delay_line_adc);
+
+	constexpr int window {9}; // skip outputs depending on samples of a previous test
+	for (int i=window-1; i<test_data.size(); ++i) {
+		BOOST_REQUIRE_EQUAL(result[i],delay_line_result[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(delay_line_and_retimed_sum)
+{
+	HLSVar<uint10,1,-1> stream;
+	HLSVar<uint11,1,-1> sum_stream;
+	auto sum = make_hls_expr([&stream](int k) { return stream.offset(k) + stream.offset(k-1); });
+	HLSVar<uint11,1,-1> var;
+	HLSDelayLine<uint11,1,-1> line;
+	for (int i=0; i<20; ++i) {
+		stream = uint10(i*37);
+		sum_stream = stream.offset(1) + stream.offset(0);
+		// the retimed expression reads the source buffer at the shifted offsets
+		BOOST_REQUIRE_EQUAL(sum.offset(1).value,sum_stream.offset(1).value);
+		BOOST_REQUIRE_EQUAL(sum.offset(0).value,sum_stream.offset(0).value);
+		// x[n] + x[n-1] - x[n-2] - x[n-3] of the component, after a window of this test
+		const int12 pair_difference = pair_sum_difference_adc(uint10(i*37));
+		if (i >= 3) {
+			BOOST_REQUIRE_EQUAL(pair_difference,37*(i + (i-1) - (i-2) - (i-3)));
+		}
+
+		// the delay line holds the offsets of the HLSVar, but repeats no sample
+		const Token<uint11> sample = (i%3 == 2) ? Token<uint11>{0,false} : Token<uint11>(i*37);
+		var = sample;
+		line = sample;
+		if (sample.valid) {
+			for (int k=-1; k<=1; ++k) {
+				BOOST_REQUIRE_EQUAL(line.offset(k).value,var.offset(k).value);
+				BOOST_REQUIRE_EQUAL(line.offset(k).valid,var.offset(k).valid);
+			}
+		} else {
+			BOOST_REQUIRE(!line.offset(1).valid);
+			BOOST_REQUIRE_EQUAL(line.offset(0).value,var.offset(1).value);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(graph_balancing)
@@ -585,3 +1002,670 @@ BOOST_AUTO_TEST_CASE(peak_finder_task_test)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(cordic_test)
+
+BOOST_AUTO_TEST_CASE(magnitude_and_phase_component)
+{
+	constexpr int SIZE = 8;
+	float i_in[SIZE] {1.0,0.0,-1.0,0.0,3.0,-2.5,-4.0,0.25};
+	float q_in[SIZE] {0.0,1.0,0.0,-1.0,4.0,2.5,-3.0,-0.75};
+	Token<fixp_20_4> magnitude[SIZE];
+	Token<fixp_20_4> phase[SIZE];
+
+	for (int i=0; i<SIZE; ++i) {
+		magnitude[i] = envelope_magnitude(fixp_20_4(i_in[i]),fixp_20_4(q_in[i]));
+		phase[i] = envelope_phase(fixp_20_4(i_in[i]),fixp_20_4(q_in[i]));
+	}
+
+	for (int i=0; i<SIZE; ++i) {
+		BOOST_REQUIRE(magnitude[i].valid);
+		BOOST_REQUIRE(phase[i].valid);
+		BOOST_REQUIRE_SMALL(magnitude[i].value.to_double() - std::hypot(i_in[i],q_in[i]),1e-3);
+		BOOST_REQUIRE_SMALL(phase[i].value.to_double() - std::atan2(q_in[i],i_in[i]),1e-3);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sine_and_cosine)
+{
+	for (int i=-12; i<=12; ++i) {
+		double angle = i*0.26;
+		Token<fixp_20_4> cos_out;
+		Token<fixp_20_4> sin_out;
+		cordic_sincos<16>(Token<fixp_20_4>(angle),cos_out,sin_out);
+		BOOST_REQUIRE(cos_out.valid && sin_out.valid);
+		BOOST_REQUIRE_SMALL(cos_out.value.to_double() - std::cos(angle),1e-3);
+		BOOST_REQUIRE_SMALL(sin_out.value.to_double() - std::sin(angle),1e-3);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(exponential_and_logarithm)
+{
+	using fixp_24_8 = ac_fixed<24,8,true>;
+	for (int i=-16; i<=16; ++i) {
+		double x = i*0.3;
+		Token<fixp_24_8> result = cordic_exp<20>(Token<fixp_24_8>(x));
+		BOOST_REQUIRE(result.valid);
+		BOOST_REQUIRE_SMALL(result.value.to_double() - std::exp(x),std::exp(x)*1e-3+1e-4);
+	}
+	for (int i=1; i<=40; ++i) {
+		double x = i*i*0.11;
+		Token<fixp_24_8> result = cordic_log<20>(Token<fixp_24_8>(x));
+		BOOST_REQUIRE(result.valid);
+		BOOST_REQUIRE_SMALL(result.value.to_double() - std::log(x),1e-3);
+	}
+	Token<fixp_24_8> invalid_token {1.0,false};
+	BOOST_REQUIRE(!cordic_exp<20>(invalid_token).valid);
+	BOOST_REQUIRE(!cordic_log<20>(invalid_token).valid);
+}
+
+BOOST_AUTO_TEST_CASE(square_root)
+{
+	using ufixp_16_10 = ac_fixed<16,10,false>;
+	for (int i=0; i<=1000; i+=7) {
+		double x = i*0.37;
+		Token<ufixp_16_10> result = cordic_sqrt<12>(Token<ufixp_16_10>(x));
+		BOOST_REQUIRE(result.valid);
+		BOOST_REQUIRE_SMALL(result.value.to_double() - std::sqrt(ufixp_16_10(x).to_double()),1.0/64);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(lookup_table_test)
+
+BOOST_AUTO_TEST_CASE(full_table_component)
+{
+	for (int i=0; i<1024; ++i) {
+		Token<uint11> result = adc_calibration_lut(static_cast<uint10>(i));
+		BOOST_REQUIRE(result.valid);
+		BOOST_REQUIRE_EQUAL(result.value,adc_calibration_curve{}(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(interpolated_table_component)
+{
+	for (int i=0; i<1024; ++i) {
+		Token<uint11> result = adc_calibration_lut_interpolated(static_cast<uint10>(i));
+		BOOST_REQUIRE(result.valid);
+		BOOST_REQUIRE_SMALL(static_cast<int>(result.value) - static_cast<int>(adc_calibration_curve{}(i)),2);
+	}
+}
+
+struct square_curve {
+	constexpr long long operator()(long long x) const { return x*x; }
+};
+
+struct decreasing_curve {
+	constexpr long long operator()(long long x) const { return 2047 - 2*x; }
+};
+
+BOOST_AUTO_TEST_CASE(decreasing_curve_top_interval)
+{
+	// F(1024) = -1 is past the input range and does not fit uint11
+	const LUT<uint10,uint11,decreasing_curve,6> interpolated;
+	for (int i=0; i<1024; ++i) {
+		Token<uint11> result = interpolated(Token<uint10>(i));
+		BOOST_REQUIRE_SMALL(static_cast<int>(result.value) - static_cast<int>(decreasing_curve{}(i)),2);
+	}
+}
+
+struct fractional_curve { // t - t^3/3 for t = (x-512)/512, in [-2/3,2/3]
+	constexpr double operator()(long long x) const {
+		const double t = (x - 512) / 512.0;
+		return t - t*t*t/3.0;
+	}
+};
+
+BOOST_AUTO_TEST_CASE(fractional_output_type)
+{
+	using fixp_16_1 = ac_fixed<16,1,true>;
+	const LUT<uint10,fixp_16_1,fractional_curve> table;
+	const LUT<uint10,fixp_16_1,fractional_curve,6> interpolated;
+	constexpr double step = 1.0/32768.0;
+	for (int i=0; i<1024; ++i) {
+		const double golden = fractional_curve{}(i);
+		BOOST_REQUIRE_SMALL(table(Token<uint10>(i)).value.to_double() - golden,step/2 + 1e-12);
+		BOOST_REQUIRE_SMALL(interpolated(Token<uint10>(i)).value.to_double() - golden,3e-4); // curvature over 16 inputs
+	}
+}
+
+BOOST_AUTO_TEST_CASE(signed_input_and_valid_propagation)
+{
+	const LUT<int6,uint11,square_curve> square;
+	for (int i=-32; i<32; ++i) {
+		Token<uint11> result = square(Token<int6>(i));
+		BOOST_REQUIRE_EQUAL(result.value,i*i);
+	}
+	const LUT<int6,uint11,square_curve,3> interpolated_square;
+	for (int i=-32; i<32; i+=8) {
+		Token<uint11> result = interpolated_square(Token<int6>(i));
+		BOOST_REQUIRE_EQUAL(result.value,i*i);
+	}
+	Token<int6> invalid_token {3,false};
+	BOOST_REQUIRE(!square(invalid_token).valid);
+	BOOST_REQUIRE(!interpolated_square(invalid_token).valid);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(rank_order_test)
+
+template<typename T, int A, int B>
+void check_window_ranks(HLSVar<T,A,B> & window, int stream_length)
+{
+	constexpr int N = A - B + 1;
+	std::vector<int> input(stream_length);
+	for (int i=0; i<stream_length; ++i) {
+		input[i] = (i*7919 + 13) % 101 - 50;
+	}
+	for (int i=0; i<stream_length; ++i) {
+		window = static_cast<T>(input[i]);
+		if (i+1 < N) {
+			BOOST_REQUIRE(!median(window).valid);
+			continue;
+		}
+		std::vector<int> sorted(input.begin()+i+1-N,input.begin()+i+1);
+		std::sort(sorted.begin(),sorted.end());
+		BOOST_REQUIRE(median(window).valid);
+		BOOST_REQUIRE_EQUAL(median(window).value,sorted[N/2]);
+		BOOST_REQUIRE_EQUAL(rank_order<0>(window).value,sorted[0]);
+		BOOST_REQUIRE_EQUAL(rank_order<N-1>(window).value,sorted[N-1]);
+		BOOST_REQUIRE_EQUAL(window_min(window).value,sorted[0]);
+		BOOST_REQUIRE_EQUAL(window_max(window).value,sorted[N-1]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sorting_network_windows)
+{
+	HLSVar<int8,1,-1> window3;
+	check_window_ranks(window3,40);
+	HLSVar<int8,2,-2> window5;
+	check_window_ranks(window5,40);
+	HLSVar<int8,5,0> window6;
+	check_window_ranks(window6,40);
+	HLSVar<int8,4,-4> window9;
+	check_window_ranks(window9,40);
+	HLSVar<int8,6,-6> window13;
+	check_window_ranks(window13,40);
+}
+
+BOOST_AUTO_TEST_CASE(median_removes_impulses)
+{
+	constexpr int SIZE = 20;
+	uint10 stream_in[SIZE] {10,10,10,1000,10,10,20,20,20,20,1023,20,20,0,20,30,30,30,30,30};
+	uint10 golden_result[SIZE] {10,10,10,10,10,20,20,20,20,20,20,20,20,20,20,30,30,30,30,30};
+	Token<uint10> stream_out[SIZE];
+
+	int stream_out_count {0};
+	for (int i=-2; i<SIZE+2; ++i) { // the border samples are extended by two
+		uint10 value = stream_in[std::min(std::max(i,0),SIZE-1)];
+		Token<uint10> result = median_filter_adc(value);
+		if (result.valid) {
+			stream_out[stream_out_count] = result;
+			++stream_out_count;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(stream_out_count,SIZE);
+
+	for (int i=0; i<SIZE; ++i) {
+		BOOST_REQUIRE_EQUAL(golden_result[i],stream_out[i].value);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sliding_median_component)
+{
+	std::vector<uint10> test_data;
+	std::ifstream input_file("data/data.dat");
+	std::string data;
+	while(std::getline(input_file,data,','))
+	{
+		float val = std::stod(data);
+		test_data.push_back(static_cast<uint10>(val));
+	}
+	input_file.close();
+
+	constexpr int N = 15;
+	for (int i=0; i<test_data.size(); ++i) {
+		Token<uint10> result = sliding_median_adc(test_data[i]);
+		BOOST_REQUIRE_EQUAL(result.valid,i+1 >= N);
+		if (result.valid) {
+			std::vector<uint10> sorted(test_data.begin()+i+1-N,test_data.begin()+i+1);
+			std::sort(sorted.begin(),sorted.end());
+			BOOST_REQUIRE_EQUAL(result.value,sorted[N/2]);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(coefficient_bank_test)
+
+BOOST_AUTO_TEST_CASE(reload_at_stream_boundary)
+{
+	constexpr int SIZE = 16;
+	int8 csr_coefficients[3] {1,2,3};
+	int10 stream_in[SIZE] {5,-3,8,1,0,7,-9,4,2,6,-1,3,5,-8,2,9};
+
+	for (int i=0; i<SIZE; ++i) {
+		bool reload = (i==5);            // copy takes the invocations 5,6,7
+		bool boundary = (i==6 || i==10); // first boundary comes before the copy is complete
+		Token<int20> result = reloadable_fir(stream_in[i],csr_coefficients,reload,boundary);
+		if (i==7) {
+			csr_coefficients[0] = 100; // already copied, must not show up
+		}
+		BOOST_REQUIRE_EQUAL(result.valid,i>=2);
+		if (result.valid) {
+			int c1 = (i<10) ? 1 : 2;
+			int c2 = (i<10) ? 1 : 3;
+			int golden = stream_in[i-2] + c1*stream_in[i-1] + c2*stream_in[i];
+			BOOST_REQUIRE_EQUAL(result.value,golden);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(lms_system_identification)
+{
+	constexpr int SIZE = 3000;
+	std::vector<double> x(SIZE);
+	unsigned int seed {12345};
+	for (int i=0; i<SIZE; ++i) {
+		seed = seed*1103515245 + 12345;
+		x[i] = ((seed >> 16) % 2001)/1000.0 - 1.0;
+	}
+	double error {0.0};
+	for (int i=0; i<SIZE; ++i) {
+		double desired = 0.5*x[i] - 0.25*(i>0 ? x[i-1] : 0.0) + 0.125*(i>1 ? x[i-2] : 0.0);
+		Token<fixp_24_4> result = lms_adaptive_fir(fixp_24_4(x[i]),fixp_24_4(desired));
+		if (i>=SIZE-100) {
+			BOOST_REQUIRE(result.valid);
+			error = std::max(error,std::abs(result.value.to_double()-desired));
+		}
+	}
+	BOOST_REQUIRE_SMALL(error,1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(delayed_lms_and_reload)
+{
+	constexpr int DELAY = 2;
+	CoefficientBank<fixp_24_4,3,DELAY> bank;
+	HLSVar<fixp_24_4,2,0> window;
+	const fixp_24_4 step {0.5};
+	const fixp_24_4 reloaded[3] {0.25,0.5,0.75};
+	for (int i=0; i<3; ++i) { window = fixp_24_4(1.0); }
+
+	// an error updates the coefficients DELAY valid errors later
+	for (int i=0; i<DELAY; ++i) {
+		bank.adapt(window,Token<fixp_24_4>(1.0),step);
+		BOOST_REQUIRE_EQUAL(bank[0].value.to_double(),0.0);
+	}
+	bank.adapt(window,Token<fixp_24_4>{1.0,false},step); // invalid errors do not advance the delay
+	BOOST_REQUIRE_EQUAL(bank[0].value.to_double(),0.0);
+	bank.adapt(window,Token<fixp_24_4>(1.0),step);
+	BOOST_REQUIRE_EQUAL(bank[0].value.to_double(),0.5);
+
+	// a swap replaces the adapted coefficients and drops the delayed errors
+	for (int i=0; i<3; ++i) {
+		bank.update(reloaded,i==0,false);
+	}
+	bank.update(reloaded,false,true);
+	for (int i=0; i<3; ++i) {
+		BOOST_REQUIRE_EQUAL(bank[i].value.to_double(),reloaded[i].to_double());
+	}
+	for (int i=0; i<DELAY; ++i) {
+		bank.adapt(window,Token<fixp_24_4>(-0.5),step);
+		BOOST_REQUIRE_EQUAL(bank[2].value.to_double(),0.75);
+	}
+	bank.adapt(window,Token<fixp_24_4>(-0.5),step);
+	BOOST_REQUIRE_EQUAL(bank[2].value.to_double(),0.5);
+}
+
+BOOST_AUTO_TEST_CASE(delayed_lms_wider_samples_and_errors)
+{
+	using coefficient_t = ac_fixed<8,2,true>;  // [-2,2)
+	using sample_t = ac_fixed<12,6,true>;      // [-32,32)
+	CoefficientBank<coefficient_t,3,1,sample_t> bank;
+	HLSVar<sample_t,2,0> window;
+	const coefficient_t step {1.0/64.0};
+	for (int i=0; i<3; ++i) { window = sample_t(10.0); }
+
+	// samples and error outside of the coefficient range, w += 1/64 * 3 * 10
+	bank.adapt(window,Token<sample_t>(3.0),step);
+	bank.adapt(window,Token<sample_t>(3.0),step);
+	for (int i=0; i<3; ++i) {
+		BOOST_REQUIRE_EQUAL(bank[i].value.to_double(),0.46875);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(systolic_matched_filter)
+{
+	constexpr int LATENCY = SystolicFIR<int10,MATCHED_TAPS/2-1,-MATCHED_TAPS/2,int8,int24,MATCHED_FANOUT>::latency;
+	BOOST_REQUIRE_EQUAL(LATENCY,MATCHED_TAPS-MATCHED_FANOUT+1);
+	constexpr int SIZE = 300;
+	std::vector<int> stream_in(SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		stream_in[i] = ((i*151) % 1024) - 512;
+	}
+
+	int out_count {0};
+	for (int i=0; i<SIZE; ++i) {
+		Token<int24> result = matched_filter_systolic(stream_in[i]);
+		BOOST_REQUIRE_EQUAL(result.valid,i >= LATENCY+MATCHED_TAPS-1);
+		if (result.valid) {
+			const int n = i - LATENCY; // direct-form output of the window ending at sample n
+			int golden {0};
+			for (int k=0; k<MATCHED_TAPS; ++k) { golden += matched_filter_coefficients[k]*stream_in[n-MATCHED_TAPS+1+k]; }
+			BOOST_REQUIRE_EQUAL(result.value,golden);
+			++out_count;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(out_count,SIZE-LATENCY-MATCHED_TAPS+1);
+}
+
+BOOST_AUTO_TEST_CASE(systolic_fir_padding_and_invalid_tokens)
+{
+	constexpr int coefficients[7] {1,-2,3,4,-3,2,1};
+	SystolicFIR<int10,3,-3,int4,int20,3> fir {coefficients}; // 7 taps in 3 segments of 3
+	constexpr int LATENCY = SystolicFIR<int10,3,-3,int4,int20,3>::latency;
+	constexpr int SIZE = 60;
+	std::vector<int> stream_in;
+	int n {0};
+	for (int t=0; t<2*SIZE; ++t) {
+		Token<int10> sample = (t%3 == 1) ? Token<int10>{0,false} : Token<int10>(((t*37) % 256) - 128);
+		Token<int20> result = (fir = sample);
+		if (!sample.valid) {
+			BOOST_REQUIRE(!result.valid);
+			continue;
+		}
+		stream_in.push_back(sample.value);
+		BOOST_REQUIRE_EQUAL(result.valid,n >= LATENCY+6);
+		if (result.valid) {
+			int golden {0};
+			for (int k=0; k<7; ++k) { golden += coefficients[k]*stream_in[n-LATENCY-6+k]; }
+			BOOST_REQUIRE_EQUAL(result.value,golden);
+		}
+		++n;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(cycle_model_test)
+
+struct three_point_sum { // fresh window state for every model
+	HLSVar<uint10,1,-1> stream;
+	Token<uint10> operator()(uint10 stream_in) {
+		stream = stream_in;
+		return stream.offset(-1) + stream.offset(0) + stream.offset(1);
+	}
+};
+
+// graph of peak_finder_adc, the divisions by 16 and 2 are shifts
+PipelineGraph peak_finder_graph(const OperatorLatency & operators) {
+	PipelineGraph graph;
+	const int stream_in = graph.input("triangular_stream_buffer");
+	const int smoothed = graph.node("smoothed_stream",{stream_in},operators.mul + operators.adder_tree(7) + operators.shift);
+	graph.node("derivative",{smoothed},operators.add + operators.shift);
+	return graph;
+}
+
+// graph of moving_avg, three samples summed and divided by the constant 3
+PipelineGraph moving_avg_graph(const OperatorLatency & operators) {
+	PipelineGraph graph;
+	graph.node("avg",{graph.input("stream")},operators.adder_tree(3) + operators.constant_divide());
+	return graph;
+}
+
+BOOST_AUTO_TEST_CASE(latency_and_initiation_interval)
+{
+	constexpr int SIZE = 40;
+	// latencies of tool/fixture/test_comp_fpga.prj
+	constexpr int PEAK_FINDER_REPORT_LATENCY = 11;
+	constexpr int MOVING_AVG_REPORT_LATENCY = 9;
+	std::vector<Token<uint10>> trace(SIZE);
+	std::vector<Token<uint10>> sparse_trace(2*SIZE);
+	for (int i=0; i<SIZE; ++i) {
+		trace[i] = Token<uint10>(i);
+		sparse_trace[2*i] = Token<uint10>(i);
+		sparse_trace[2*i+1] = Token<uint10>{0,false};
+	}
+
+	// calibrated on peak_finder_adc, moving_avg is predicted without refitting
+	const OperatorLatency operators = calibrate(OperatorLatency{},peak_finder_graph(OperatorLatency{}),PEAK_FINDER_REPORT_LATENCY);
+	BOOST_REQUIRE_EQUAL(peak_finder_graph(operators).stages(),3+3+1); // multiply, adder tree of 7, derivative
+	BOOST_REQUIRE_EQUAL(moving_avg_graph(operators).stages(),2+3);    // adder tree of 3, reciprocal multiply
+	BOOST_REQUIRE_EQUAL(moving_avg_graph(operators).latency(operators),MOVING_AVG_REPORT_LATENCY);
+	BOOST_REQUIRE_EQUAL(moving_avg_graph(operators).initiation_interval(),1);
+
+	PipelineGraph three_point_graph;
+	three_point_graph.node("sum",{three_point_graph.input("stream")},operators.adder_tree(3));
+	const int pipeline_latency = three_point_graph.latency(operators);
+	std::vector<CycleReport> reports;
+	reports.push_back(make_cycle_model("three_point_sum",three_point_sum{},three_point_graph,operators).run(trace));
+	BOOST_REQUIRE_EQUAL(reports.back().latency,2+pipeline_latency); // window of three samples
+	BOOST_REQUIRE_CLOSE(reports.back().initiation_interval,1.0,1e-9);
+	BOOST_REQUIRE_EQUAL(reports.back().outputs,SIZE-2);
+
+	reports.push_back(make_cycle_model("three_point_sum sparse input",three_point_sum{},three_point_graph,operators).run(sparse_trace));
+	BOOST_REQUIRE_EQUAL(reports.back().latency,4+pipeline_latency);
+	BOOST_REQUIRE_CLOSE(reports.back().initiation_interval,2.0,1e-9);
+
+	// sum fed back through a multiply-add, a task with II 4 behind a FIFO of 4 tokens
+	PipelineGraph accumulating_graph = three_point_graph;
+	accumulating_graph.recurrence(operators.mul + operators.add);
+	BOOST_REQUIRE_EQUAL(accumulating_graph.initiation_interval(),4);
+	reports.push_back(make_cycle_model("three_point_sum task",three_point_sum{},accumulating_graph,operators,4).run(trace));
+	BOOST_REQUIRE_CLOSE(reports.back().initiation_interval,4.0,1e-9);
+	BOOST_REQUIRE_EQUAL(reports.back().max_fifo_occupancy,4);
+	BOOST_REQUIRE(reports.back().stall_cycles > 0);
+
+	// LMS weights of lms_adaptive_fir: without delay the whole filter and update are in
+	// the recurrence, with the delayed error of CoefficientBank only the accumulation
+	PipelineGraph lms_graph;
+	lms_graph.node("filtered",{lms_graph.input("stream")},operators.mul + operators.adder_tree(3));
+	lms_graph.recurrence(operators.mul + operators.adder_tree(3) + operators.add + 2*operators.mul + operators.add);
+	BOOST_REQUIRE_EQUAL(lms_graph.initiation_interval(),13);
+	PipelineGraph delayed_lms_graph;
+	delayed_lms_graph.node("filtered",{delayed_lms_graph.input("stream")},operators.mul + operators.adder_tree(3));
+	delayed_lms_graph.recurrence(operators.add);
+	BOOST_REQUIRE_EQUAL(delayed_lms_graph.initiation_interval(),1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(range_analysis_test)
+
+BOOST_AUTO_TEST_CASE(minimal_types_of_recorded_values)
+{
+	uint14 adc_sum;
+	int11 derivative;
+	fixp_33_23 fixp_value;
+	uint14 wrapping_sum;
+	int unnamed;
+	range_analysis::name(&adc_sum,"range_test","adc_sum");
+	range_analysis::name(&derivative,"range_test","derivative");
+	range_analysis::name(&fixp_value,"range_test","fixp_value");
+	range_analysis::name(&wrapping_sum,"range_test","wrapping_sum");
+	range_analysis::reset();
+	for (int i=0; i<=700; ++i) {
+		range_analysis::record<uint14>(&adc_sum,uint14(i));
+		range_analysis::record<int11>(&derivative,Token<int11>(i-300,i<=500)); // invalid tokens are not recorded
+		range_analysis::record<int>(&unnamed,i);
+		range_analysis::record<uint14>(&wrapping_sum,Token<int>(16000+4*i)); // int values, which wrap in uint14
+	}
+	range_analysis::record<fixp_33_23>(&fixp_value,fixp_33_23(0.25));
+	range_analysis::record<fixp_33_23>(&fixp_value,fixp_33_23(-1.5));
+	range_analysis::record<fixp_33_23>(&fixp_value,fixp_33_23(3.75));
+
+	const std::vector<range_analysis::NodeRange> nodes = range_analysis::nodes();
+	BOOST_REQUIRE_EQUAL(nodes.size(),4);
+	for (const range_analysis::NodeRange & node : nodes) {
+		if (node.name == "range_test::adc_sum") {
+			BOOST_REQUIRE_EQUAL(node.declared_type,"ac_int<14,false>");
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_int<10,false>");
+			BOOST_REQUIRE_EQUAL(node.samples,701);
+			BOOST_REQUIRE_EQUAL(node.overflows,0);
+		} else if (node.name == "range_test::wrapping_sum") {
+			BOOST_REQUIRE_EQUAL(node.max,16000+4*700);
+			BOOST_REQUIRE_EQUAL(node.overflows,700-95); // above 16383
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_int<15,false>");
+		} else if (node.name == "range_test::derivative") {
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_int<10,true>"); // -300 to 200
+			BOOST_REQUIRE_EQUAL(node.samples,501);
+		} else {
+			BOOST_REQUIRE_EQUAL(node.name,"range_test::fixp_value");
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_fixed<5,3,true>");
+		}
+	}
+	range_analysis::report(std::cout,true);
+	range_analysis::reset();
+}
+
+#ifdef HLS_RANGE_ANALYSIS
+BOOST_AUTO_TEST_CASE(data_set_report)
+{
+	std::vector<float> test_data;
+	std::ifstream input_file("data/data.dat");
+	std::string data;
+	while(std::getline(input_file,data,','))
+	{
+		test_data.push_back(std::stod(data));
+	}
+	input_file.close();
+	std::vector<float> big_test_data;
+	std::ifstream big_input_file("data/dataBig.dat");
+	while(std::getline(big_input_file,data,','))
+	{
+		big_test_data.push_back(std::stod(data));
+	}
+	big_input_file.close();
+
+	range_analysis::reset();
+	for (float sample : test_data) {
+		peak_finder_adc(static_cast<uint10>(sample));
+	}
+	for (float sample : big_test_data) {
+		derivation_fixp(fixp_33_23(sample));
+	}
+
+	std::ofstream output_file("result/range_report.dat");
+	range_analysis::report(output_file,true);
+	output_file.close();
+	range_analysis::report(std::cout,true);
+
+	for (const range_analysis::NodeRange & node : range_analysis::nodes()) {
+		if (node.name == "peak_finder_adc::smoothed_stream") {
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_int<10,false>"); // smoothed uint10 samples
+		} else if (node.name == "peak_finder_adc::derivative") {
+			// difference of two uint14 tokens, recorded before it wraps in the subtraction
+			BOOST_REQUIRE(node.min < 0);
+			BOOST_REQUIRE_EQUAL(node.overflows,0);
+			BOOST_REQUIRE_EQUAL(node.recommended_type(),"ac_int<8,true>");
+		}
+	}
+	BOOST_REQUIRE_EQUAL(range_analysis::nodes().size(),5);
+}
+
+BOOST_AUTO_TEST_CASE(overflow_of_named_stream)
+{
+	static HLSVar<uint14> narrow_stream;
+	range_analysis::name(&narrow_stream,"range_test","narrow_stream");
+	range_analysis::reset();
+	for (int i=10000; i<=19000; i+=1000) {
+		narrow_stream = Token<int>(i);
+	}
+	const std::vector<range_analysis::NodeRange> nodes = range_analysis::nodes();
+	BOOST_REQUIRE_EQUAL(nodes.size(),1);
+	BOOST_REQUIRE_EQUAL(nodes[0].min,10000);
+	BOOST_REQUIRE_EQUAL(nodes[0].max,19000);
+	BOOST_REQUIRE_EQUAL(nodes[0].overflows,3); // 17000 to 19000 wrap in uint14
+	BOOST_REQUIRE_EQUAL(nodes[0].recommended_type(),"ac_int<15,false>");
+	std::ostringstream report;
+	range_analysis::report(report);
+	BOOST_REQUIRE(report.str().find("OVERFLOW") != std::string::npos);
+	range_analysis::reset();
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(stream_routing_test)
+
+BOOST_AUTO_TEST_CASE(select_broadcast_and_demux)
+{
+	const Token<int> a {3,true};
+	const Token<int> b {5,false};
+	BOOST_REQUIRE_EQUAL(select(true,a,b).value,3);
+	BOOST_REQUIRE(!select(false,a,b).valid);
+
+	const Token<uint10> inputs[3] {Token<uint10>(1),Token<uint10>{2,false},Token<uint10>(3)};
+	BOOST_REQUIRE_EQUAL(select(2,inputs).value,3);
+	BOOST_REQUIRE(!select(1,inputs).valid);
+	BOOST_REQUIRE(!select(3,inputs).valid);
+
+	Token<uint14> copies[4];
+	HLSVar<uint10> stream;
+	stream = uint10(7);
+	broadcast(stream,copies);
+	for (const Token<uint14> & copy : copies) {
+		BOOST_REQUIRE(copy.valid);
+		BOOST_REQUIRE_EQUAL(copy.value,7);
+	}
+
+	Token<uint10> outputs[3];
+	demux(1,Token<uint10>(9),outputs);
+	BOOST_REQUIRE(!outputs[0].valid && outputs[1].valid && !outputs[2].valid);
+	BOOST_REQUIRE_EQUAL(outputs[1].value,9);
+	demux(1,Token<uint10>{9,false},outputs);
+	BOOST_REQUIRE(!outputs[1].valid);
+}
+
+BOOST_AUTO_TEST_CASE(round_robin_merge_component)
+{
+	// both producers deliver a token every other invocation, in the same invocation
+	constexpr int SIZE = 40;
+	std::vector<int> merged;
+	for (int t=0; t<2*SIZE+4; ++t) {
+		const bool valid = (t%2 == 0) && (t < 2*SIZE);
+		Token<uint10> result = round_robin_merge_adc(Token<uint10>{uint10(t/2),valid},Token<uint10>{uint10(512+t/2),valid});
+		if (result.valid) {
+			merged.push_back(result.value);
+		}
+	}
+	BOOST_REQUIRE_EQUAL(merged.size(),2*SIZE);
+	for (int i=0; i<SIZE; ++i) { // alternating sources, each in order
+		BOOST_REQUIRE_EQUAL(merged[2*i],i);
+		BOOST_REQUIRE_EQUAL(merged[2*i+1],512+i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(priority_merge_and_overflow)
+{
+	Merge<int,3,MergePolicy::priority,2> merge;
+	Token<int> inputs[3] {Token<int>(10),Token<int>(20),Token<int>(30)};
+	Token<int> result = (merge = inputs);
+	BOOST_REQUIRE_EQUAL(result.value,10);
+	BOOST_REQUIRE_EQUAL(merge.source(),0);
+	inputs[0] = Token<int>{0,false};
+	inputs[1] = Token<int>{0,false};
+	inputs[2] = Token<int>{0,false};
+	result = (merge = inputs);
+	BOOST_REQUIRE_EQUAL(result.value,20);
+	result = (merge = inputs);
+	BOOST_REQUIRE_EQUAL(result.value,30);
+	BOOST_REQUIRE_EQUAL(merge.source(),2);
+	result = (merge = inputs);
+	BOOST_REQUIRE(!result.valid);
+	BOOST_REQUIRE(!merge.overflow());
+
+	// input 0 at full rate starves input 2, whose queue overflows
+	for (int t=0; t<4; ++t) {
+		inputs[0] = Token<int>(t);
+		inputs[2] = Token<int>(100+t);
+		result = (merge = inputs);
+		BOOST_REQUIRE_EQUAL(result.value,t);
+	}
+	BOOST_REQUIRE(merge.overflow());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
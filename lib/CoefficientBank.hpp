@@ -0,0 +1,147 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_COEFFICIENTBANK_HPP_
+#define LIB_COEFFICIENTBANK_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+// Double buffered coefficients of an N-tap stencil, reloadable at runtime from a
+// component argument like an hls_avalon_slave_memory_argument. The coefficients are
+// copied one per invocation into a shadow bank, so the CSR memory needs a single read
+// port and the II=1 pipeline never stalls. The shadow bank becomes active at the
+// next stream boundary after the copy is complete, so the coefficient set of a
+// stencil changes atomically. In adaptive mode the active coefficients are updated
+// by the delayed LMS rule from an error stream: the error and the window of an output
+// are registered for LMS_DELAY valid samples before they update the coefficients, so
+// the coefficient update is not in one loop-carried path with the filter output and
+// its error, and the pipeline keeps II=1. The delayed samples and errors keep their
+// types S and E, only the coefficient update is narrowed to T. A bank swap by update() replaces the adapted
+// coefficients with the reloaded ones and drops the delayed errors, which belong to the
+// coefficients before the swap.
+template<typename T, int N, int LMS_DELAY = 2, typename S = T, typename E = S>
+class CoefficientBank {
+private:
+	hls_register T active[N];
+	hls_register T shadow[N];
+	int load_index {0};
+	bool loading {false};
+	bool loaded {false};
+	hls_register E delayed_error[LMS_DELAY];
+	hls_register S delayed_window[LMS_DELAY][N];
+	bool delayed_valid[LMS_DELAY] {};
+
+	static_assert(LMS_DELAY > 0, "the LMS update needs a delay of at least one sample");
+
+public:
+
+	CoefficientBank() {
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			active[i] = 0;
+			shadow[i] = 0;
+		}
+	}
+
+	CoefficientBank(const T (&initial)[N]) {
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			active[i] = initial[i];
+			shadow[i] = initial[i];
+		}
+	}
+
+	// starts a reload from csr_memory when requested, copies one coefficient and
+	// swaps the banks at a stream boundary once the copy is complete
+	void update(const T * csr_memory, bool reload_request, bool stream_boundary) {
+		if (reload_request && !loading && !loaded) {
+			loading = true;
+			load_index = 0;
+		}
+		if (loading) {
+			shadow[load_index] = csr_memory[load_index];
+			loading = (load_index != N-1);
+			loaded = (load_index == N-1);
+			++load_index;
+		}
+		if (loaded && stream_boundary) {
+			#pragma unroll
+			for (int i = 0; i < N; ++i) {
+				active[i] = shadow[i];
+			}
+			#pragma unroll
+			for (int d = 0; d < LMS_DELAY; ++d) {
+				delayed_valid[d] = false;
+			}
+			loaded = false;
+		}
+	}
+
+	Token<T> operator[](int index) const {
+		return {active[index], true};
+	}
+
+	// dot product of the active coefficients with the window of an HLSVar, coefficient
+	// zero belongs to the lowest offset
+	template<typename R, typename W, int A, int B>
+	Token<R> apply(const HLSVar<W,A,B> & window) const {
+		constexpr int lowest_offset = (B > 0) ? 0 : B;
+		constexpr int highest_offset = (A < 0) ? 0 : A;
+		static_assert(highest_offset - lowest_offset + 1 == N, "window size does not match the number of coefficients");
+		R sum {0};
+		bool valid {true};
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			sum = sum + active[i] * window.offset(lowest_offset + i).value;
+			valid = valid && window.offset(lowest_offset + i).valid;
+		}
+		return {sum, valid};
+	}
+
+	// delayed LMS update w[i] += step * e[n-D] * x[n-D][i], the error is passed with the
+	// window its filter output was computed from, both are delayed by D = LMS_DELAY
+	// valid errors as S and E, the full precision update is quantised to T
+	template<typename W, int A, int B, typename R>
+	void adapt(const HLSVar<W,A,B> & window, const Token<R> & error, const T & step) {
+		constexpr int lowest_offset = (B > 0) ? 0 : B;
+		bool valid {error.valid};
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			valid = valid && window.offset(lowest_offset + i).valid;
+		}
+		if (valid) {
+			if (delayed_valid[LMS_DELAY-1]) {
+				const auto scaled_error = step * delayed_error[LMS_DELAY-1];
+				#pragma unroll
+				for (int i = 0; i < N; ++i) {
+					active[i] = active[i] + scaled_error * delayed_window[LMS_DELAY-1][i];
+				}
+			}
+			#pragma unroll
+			for (int d = LMS_DELAY-1; d > 0; --d) {
+				delayed_error[d] = delayed_error[d-1];
+				delayed_valid[d] = delayed_valid[d-1];
+				#pragma unroll
+				for (int i = 0; i < N; ++i) {
+					delayed_window[d][i] = delayed_window[d-1][i];
+				}
+			}
+			delayed_error[0] = error.value;
+			delayed_valid[0] = true;
+			#pragma unroll
+			for (int i = 0; i < N; ++i) {
+				delayed_window[0][i] = window.offset(lowest_offset + i).value;
+			}
+		}
+	}
+
+};
+
+#endif /* LIB_COEFFICIENTBANK_HPP_ */
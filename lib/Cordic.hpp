@@ -0,0 +1,306 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_CORDIC_HPP_
+#define LIB_CORDIC_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+
+// CORDIC nodes for ac_fixed token streams. Every node is a fully unrolled
+// shift-add network with ITERATIONS stages, so the compiler pipelines it at II=1.
+// The result is valid when all operands are valid.
+
+namespace cordic_detail {
+
+constexpr double pi {3.14159265358979323846};
+constexpr double ln2 {0.69314718055994530942};
+constexpr double log2e {1.44269504088896340736};
+
+constexpr double pow2(int exponent) {
+	double result {1.0};
+	for (int i = 0; i < exponent; ++i) { result *= 2.0; }
+	for (int i = 0; i > exponent; --i) { result *= 0.5; }
+	return result;
+}
+
+constexpr double sqrt(double value) {
+	double x = (value > 1.0) ? value : 1.0;
+	for (int i = 0; i < 64; ++i) { x = 0.5 * (x + value / x); }
+	return x;
+}
+
+// atan(2^-i) by its power series, atan(1) is given directly
+constexpr double atan_pow2(int i) {
+	if (i == 0) { return pi / 4.0; }
+	const double x = pow2(-i);
+	double term = x;
+	double sum {0.0};
+	for (int k = 0; k < 32; ++k) {
+		sum += ((k % 2) ? -term : term) / (2 * k + 1);
+		term *= x * x;
+	}
+	return sum;
+}
+
+// atanh(2^-i) by its power series, defined for i >= 1
+constexpr double atanh_pow2(int i) {
+	const double x = pow2(-i);
+	double term = x;
+	double sum {0.0};
+	for (int k = 0; k < 32; ++k) {
+		sum += term / (2 * k + 1);
+		term *= x * x;
+	}
+	return sum;
+}
+
+// shift of the hyperbolic iteration step, iterations 4, 13, 40, ... are repeated to converge
+constexpr int hyperbolic_shift(int step) {
+	int shift {1};
+	int repeat_at {4};
+	bool repeated {false};
+	for (int k = 0; k < step; ++k) {
+		if (shift == repeat_at && !repeated) {
+			repeated = true;
+		} else {
+			if (shift == repeat_at) { repeat_at = 3 * repeat_at + 1; }
+			repeated = false;
+			++shift;
+		}
+	}
+	return shift;
+}
+
+constexpr int clog2(int value) {
+	int bits {0};
+	while ((1 << bits) < value) { ++bits; }
+	return bits;
+}
+
+template<int N>
+struct Table {
+	double circular_angle[N];
+	double hyperbolic_angle[N];
+	int hyperbolic_shift[N];
+	double circular_gain_inv;
+	double hyperbolic_gain_inv;
+	constexpr Table() : circular_angle{}, hyperbolic_angle{}, hyperbolic_shift{}, circular_gain_inv{1.0}, hyperbolic_gain_inv{1.0} {
+		double circular_gain {1.0};
+		double hyperbolic_gain {1.0};
+		for (int i = 0; i < N; ++i) {
+			const int shift = cordic_detail::hyperbolic_shift(i);
+			circular_angle[i] = atan_pow2(i);
+			hyperbolic_angle[i] = atanh_pow2(shift);
+			hyperbolic_shift[i] = shift;
+			circular_gain *= sqrt(1.0 + pow2(-2 * i));
+			hyperbolic_gain *= sqrt(1.0 - pow2(-2 * shift));
+		}
+		circular_gain_inv = 1.0 / circular_gain;
+		hyperbolic_gain_inv = 1.0 / hyperbolic_gain;
+	}
+};
+
+template<int N>
+constexpr Table<N> table {};
+
+// internal data path: three more integer bits for the sign, the CORDIC gain and the
+// quadrant correction, clog2(N)+2 guard bits against the truncation of the shifted operands
+template<int N, int W, int I>
+using work_t = ac_fixed<W + 3 + clog2(N) + 2, I + 3, true>;
+
+template<int N, int W, int I>
+using angle_t = ac_fixed<W - I + clog2(N) + 2 + 3, 3, true>;
+
+}
+
+// circular vectoring mode, returns the magnitude sqrt(x^2+y^2) with the gain compensated
+template<int ITERATIONS, int W, int I, bool S>
+Token<ac_fixed<W,I,S>> cordic_magnitude(const Token<ac_fixed<W,I,S>> & x, const Token<ac_fixed<W,I,S>> & y) {
+	using work_t = cordic_detail::work_t<ITERATIONS,W,I>;
+	constexpr auto & table = cordic_detail::table<ITERATIONS>;
+	work_t x_stage = (x.value < 0) ? work_t(-x.value) : work_t(x.value);
+	work_t y_stage = y.value;
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const work_t x_shifted = x_stage >> i;
+		const work_t y_shifted = y_stage >> i;
+		if (y_stage < 0) {
+			x_stage = x_stage - y_shifted;
+			y_stage = y_stage + x_shifted;
+		} else {
+			x_stage = x_stage + y_shifted;
+			y_stage = y_stage - x_shifted;
+		}
+	}
+	const work_t gain_inv {table.circular_gain_inv};
+	return {x_stage * gain_inv, x.valid && y.valid};
+}
+
+// circular vectoring mode, returns atan2(y,x) in radians, the result type needs
+// at least three signed integer bits to hold [-pi,pi]
+template<int ITERATIONS, int W, int I, bool S>
+Token<ac_fixed<W,I,S>> cordic_atan2(const Token<ac_fixed<W,I,S>> & y, const Token<ac_fixed<W,I,S>> & x) {
+	using work_t = cordic_detail::work_t<ITERATIONS,W,I>;
+	using angle_t = cordic_detail::angle_t<ITERATIONS,W,I>;
+	constexpr auto & table = cordic_detail::table<ITERATIONS>;
+	const bool left_half_plane = x.value < 0;
+	work_t x_stage = left_half_plane ? work_t(-x.value) : work_t(x.value);
+	work_t y_stage = left_half_plane ? work_t(-y.value) : work_t(y.value);
+	const angle_t pi {cordic_detail::pi};
+	angle_t z_stage = !left_half_plane ? angle_t(0) : (y.value < 0) ? angle_t(-pi) : pi;
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const work_t x_shifted = x_stage >> i;
+		const work_t y_shifted = y_stage >> i;
+		const angle_t angle {table.circular_angle[i]};
+		if (y_stage < 0) {
+			x_stage = x_stage - y_shifted;
+			y_stage = y_stage + x_shifted;
+			z_stage = z_stage - angle;
+		} else {
+			x_stage = x_stage + y_shifted;
+			y_stage = y_stage - x_shifted;
+			z_stage = z_stage + angle;
+		}
+	}
+	return {z_stage, x.valid && y.valid};
+}
+
+// circular rotation mode, rotates the unit vector by angle (radians, [-pi,pi]) and
+// returns cos(angle) in x and sin(angle) in y
+template<int ITERATIONS, int W, int I, bool S>
+void cordic_sincos(const Token<ac_fixed<W,I,S>> & angle, Token<ac_fixed<W,I,S>> & cos_out, Token<ac_fixed<W,I,S>> & sin_out) {
+	using work_t = cordic_detail::work_t<ITERATIONS,W,I>;
+	using angle_t = cordic_detail::angle_t<ITERATIONS,W,I>;
+	constexpr auto & table = cordic_detail::table<ITERATIONS>;
+	const angle_t half_pi {cordic_detail::pi / 2.0};
+	const angle_t pi {cordic_detail::pi};
+	const bool upper_fold = angle.value > half_pi;
+	const bool lower_fold = angle.value < -half_pi;
+	angle_t z_stage = upper_fold ? angle_t(angle.value - pi) : lower_fold ? angle_t(angle.value + pi) : angle_t(angle.value);
+	work_t x_stage {table.circular_gain_inv};
+	work_t y_stage {0};
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const work_t x_shifted = x_stage >> i;
+		const work_t y_shifted = y_stage >> i;
+		const angle_t step_angle {table.circular_angle[i]};
+		if (z_stage < 0) {
+			x_stage = x_stage + y_shifted;
+			y_stage = y_stage - x_shifted;
+			z_stage = z_stage + step_angle;
+		} else {
+			x_stage = x_stage - y_shifted;
+			y_stage = y_stage + x_shifted;
+			z_stage = z_stage - step_angle;
+		}
+	}
+	const bool negate = upper_fold || lower_fold;
+	cos_out = Token<ac_fixed<W,I,S>>{negate ? work_t(-x_stage) : x_stage, angle.valid};
+	sin_out = Token<ac_fixed<W,I,S>>{negate ? work_t(-y_stage) : y_stage, angle.valid};
+}
+
+// hyperbolic rotation mode, exp(x) = 2^q * (cosh(r) + sinh(r)) with x = q*ln2 + r
+template<int ITERATIONS, int W, int I, bool S>
+Token<ac_fixed<W,I,S>> cordic_exp(const Token<ac_fixed<W,I,S>> & x) {
+	using work_t = cordic_detail::work_t<ITERATIONS,W,I>;
+	using angle_t = ac_fixed<W + cordic_detail::clog2(ITERATIONS) + 2 + 2, I + 2, true>;
+	using scale_t = ac_fixed<W + 3 + cordic_detail::clog2(ITERATIONS) + 2 + I, 2 * I + 3, true>;
+	constexpr auto & table = cordic_detail::table<ITERATIONS>;
+	const angle_t log2e {cordic_detail::log2e};
+	const angle_t ln2 {cordic_detail::ln2};
+	const int quotient = angle_t(x.value * log2e).to_int();
+	angle_t z_stage = x.value - quotient * ln2;
+	work_t x_stage {table.hyperbolic_gain_inv};
+	work_t y_stage {0};
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const int shift = table.hyperbolic_shift[i];
+		const work_t x_shifted = x_stage >> shift;
+		const work_t y_shifted = y_stage >> shift;
+		const angle_t step_angle {table.hyperbolic_angle[i]};
+		if (z_stage < 0) {
+			x_stage = x_stage - y_shifted;
+			y_stage = y_stage - x_shifted;
+			z_stage = z_stage + step_angle;
+		} else {
+			x_stage = x_stage + y_shifted;
+			y_stage = y_stage + x_shifted;
+			z_stage = z_stage - step_angle;
+		}
+	}
+	const scale_t mantissa = x_stage + y_stage;
+	const scale_t result = (quotient < 0) ? scale_t(mantissa >> (-quotient)) : scale_t(mantissa << quotient);
+	return {result, x.valid};
+}
+
+// hyperbolic vectoring mode, ln(x) = 2*atanh((m-1)/(m+1)) + e*ln2 with x = m*2^e, m in [0.5,1),
+// the input has to be positive
+template<int ITERATIONS, int W, int I, bool S>
+Token<ac_fixed<W,I,S>> cordic_log(const Token<ac_fixed<W,I,S>> & x) {
+	using mantissa_t = ac_fixed<W + 2 + cordic_detail::clog2(ITERATIONS) + 2, 2, true>;
+	using angle_t = ac_fixed<W - I + cordic_detail::clog2(ITERATIONS) + 2 + cordic_detail::clog2(W) + 2, cordic_detail::clog2(W) + 2, true>;
+	constexpr auto & table = cordic_detail::table<ITERATIONS>;
+	const ac_int<W,false> raw = x.value.template slc<W>(0);
+	int msb {0};
+	#pragma unroll
+	for (int bit = 0; bit < W; ++bit) {
+		if (raw[bit]) { msb = bit; }
+	}
+	const ac_int<W,false> normalized = raw << (W - 1 - msb);
+	mantissa_t mantissa {0};
+	mantissa.set_slc(mantissa_t::width - 2 - W, normalized);
+	const int exponent = msb - (W - I) + 1;
+	mantissa_t x_stage = mantissa + 1;
+	mantissa_t y_stage = mantissa - 1;
+	angle_t z_stage {0};
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const int shift = table.hyperbolic_shift[i];
+		const mantissa_t x_shifted = x_stage >> shift;
+		const mantissa_t y_shifted = y_stage >> shift;
+		const angle_t step_angle {table.hyperbolic_angle[i]};
+		if (y_stage < 0) {
+			x_stage = x_stage + y_shifted;
+			y_stage = y_stage + x_shifted;
+			z_stage = z_stage - step_angle;
+		} else {
+			x_stage = x_stage - y_shifted;
+			y_stage = y_stage - x_shifted;
+			z_stage = z_stage + step_angle;
+		}
+	}
+	const angle_t ln2 {cordic_detail::ln2};
+	return {(z_stage << 1) + exponent * ln2, x.valid};
+}
+
+// digit-by-digit square root, each of the ITERATIONS stages resolves one result bit
+// starting at the most significant integer bit of the root
+template<int ITERATIONS, int W, int I, bool S>
+Token<ac_fixed<W,I,S>> cordic_sqrt(const Token<ac_fixed<W,I,S>> & x) {
+	constexpr int root_msb = (I + 1) / 2 - 1;
+	constexpr int root_lsb = root_msb - ITERATIONS + 1;
+	constexpr int fraction_bits = (2 * (-root_lsb) > (W - I)) ? 2 * (-root_lsb) : (W - I);
+	using work_t = ac_fixed<I + 3 + fraction_bits, I + 3, true>;
+	work_t remainder = x.value;
+	work_t root {0};
+	#pragma unroll
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const int bit = root_msb - i;
+		const work_t root_bit {cordic_detail::pow2(bit)};
+		const work_t trial = ((bit >= 0) ? work_t(root << (bit + 1)) : work_t(root >> (-bit - 1))) + work_t(cordic_detail::pow2(2 * bit));
+		if (remainder >= trial) {
+			remainder = remainder - trial;
+			root = root + root_bit;
+		}
+	}
+	return {root, x.valid};
+}
+
+#endif /* LIB_CORDIC_HPP_ */
@@ -0,0 +1,86 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_FOLDEDSTENCIL_HPP_
+#define LIB_FOLDEDSTENCIL_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+// Weighted sum over the window of an HLSVar<T,MAX_OFFSET,MIN_OFFSET> with the
+// multipliers and adders folded by the factor FOLD. The taps are split into FOLD
+// phases of ceil(N/FOLD) taps, and each invocation evaluates one phase into a partial
+// sum, so the stencil needs ceil(N/FOLD) multipliers instead of N. The stream accepts
+// one valid sample every FOLD invocations, the weighted sum of that sample's window is
+// valid FOLD-1 invocations later. A valid sample arriving earlier restarts the fold
+// and the unfinished sum is dropped.
+template<typename T, int MAX_OFFSET, int MIN_OFFSET, typename C, typename ACC, int FOLD>
+class FoldedStencil {
+private:
+	constexpr static int lowest_offset = (MIN_OFFSET > 0) ? 0 : MIN_OFFSET;
+	constexpr static int highest_offset = (MAX_OFFSET < 0) ? 0 : MAX_OFFSET;
+	constexpr static int taps = highest_offset - lowest_offset + 1;
+	constexpr static int taps_per_phase = (taps + FOLD - 1) / FOLD;
+
+	static_assert(FOLD > 0, "folding factor has to be positive");
+
+	HLSVar<T,MAX_OFFSET,MIN_OFFSET> window;
+	C coefficients[FOLD * taps_per_phase];
+	hls_register ACC partial_sum {0};
+	bool partial_valid {false};
+	int phase {0};
+	bool busy {false};
+
+public:
+
+	FoldedStencil(const C (&coefficients_param)[taps]) {
+		#pragma unroll
+		for (int i = 0; i < FOLD * taps_per_phase; ++i) {
+			coefficients[i] = (i < taps) ? coefficients_param[i] : C(0);
+		}
+	}
+
+	template<typename S>
+	Token<ACC> operator=(const Token<S> & rhs) {
+		if (rhs.valid) {
+			window = rhs;
+			phase = 0;
+			busy = true;
+		}
+		Token<ACC> output {0,false};
+		if (busy) {
+			ACC sum = (phase == 0) ? ACC(0) : partial_sum;
+			bool valid = (phase == 0) ? true : partial_valid;
+			#pragma unroll
+			for (int j = 0; j < taps_per_phase; ++j) {
+				const int tap = phase * taps_per_phase + j;
+				const int offset_val = (tap < taps) ? lowest_offset + tap : lowest_offset;
+				const Token<T> sample = window.offset(offset_val);
+				sum = sum + coefficients[tap] * sample.value;
+				valid = valid && sample.valid;
+			}
+			partial_sum = sum;
+			partial_valid = valid;
+			if (phase == FOLD-1) {
+				output = Token<ACC>{sum,valid};
+				busy = false;
+			} else {
+				++phase;
+			}
+		}
+		return output;
+	}
+
+	Token<ACC> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+};
+
+#endif /* LIB_FOLDEDSTENCIL_HPP_ */
@@ -0,0 +1,109 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_HLSBLOCK_HPP_
+#define LIB_HLSBLOCK_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include <cstddef>
+#include "Token.hpp"
+
+// Host-only block processing of an HLSVar stencil. The stencil is written once as a
+// function object with a templated operator()(const W & stream), which reads the
+// stream with offset() only. In a component it is evaluated on an HLSVar sample by
+// sample, on the host process_block() evaluates it over contiguous blocks of a
+// linear buffer. The window state is carried across blocks and the buffer starts with
+// invalid zero tokens like an HLSVar, so every output is bit-exact with the
+// per-invocation path. A cascaded graph takes one HLSBlock per HLSVar: the token
+// overload of process_block() skips invalid input tokens like an HLSVar assignment
+// and returns the output tokens with their valid bits, which feed the next stage
+// block by block. The loop over a block of raw samples has no loop-carried
+// dependency, so an optimising host build (HOSTFLAGS in the Makefile) can vectorise
+// it; the default -g build does not.
+#ifndef HLS_SYNTHESIS
+
+template<typename T, int MAX_OFFSET=0, int MIN_OFFSET=0, int BLOCK=4096>
+class HLSBlock {
+private:
+	constexpr static int maximal_offset = (MAX_OFFSET<0) ? 0 : MAX_OFFSET;
+	constexpr static int minimal_offset = (MIN_OFFSET>0) ? 0 : (-1)*MIN_OFFSET;
+	constexpr static int history = minimal_offset + maximal_offset;
+	constexpr static int carried = history + 1; // window of the last sample
+
+	// window of one output, offset(0) of the HLSVar it replaces
+	struct Window {
+		const T * value;
+		const bool * valid;
+		Token<T> offset(int offset_val) const {
+			return {value[offset_val], valid[offset_val]};
+		}
+	};
+
+	T value[carried + BLOCK] {};
+	bool valid[carried + BLOCK] {};
+
+	// window with the sample at buffer position newest at offset MAX_OFFSET
+	Window window(int newest) const {
+		return Window{value + newest - maximal_offset, valid + newest - maximal_offset};
+	}
+
+	void carry(int written) {
+		for (int i = 0; i < carried; ++i) {
+			value[i] = value[written + i];
+			valid[i] = valid[written + i];
+		}
+	}
+
+public:
+
+	// raw samples, all valid, the output values without valid bits
+	template<typename S, typename R, typename F>
+	void process_block(const S * in, R * out, std::size_t n, const F & stencil) {
+		while (n > 0) {
+			const std::size_t block = (n < BLOCK) ? n : BLOCK;
+			for (std::size_t i = 0; i < block; ++i) {
+				value[carried + i] = in[i];
+				valid[carried + i] = true;
+			}
+			for (std::size_t i = 0; i < block; ++i) {
+				out[i] = stencil(window(carried + i)).value;
+			}
+			carry(block);
+			in += block;
+			out += block;
+			n -= block;
+		}
+	}
+
+	// token stream, an invalid input token is not shifted in and the stencil is
+	// evaluated on the unchanged window, like an HLSVar assignment in a component
+	template<typename S, typename R, typename F>
+	void process_block(const Token<S> * in, Token<R> * out, std::size_t n, const F & stencil) {
+		while (n > 0) {
+			const std::size_t block = (n < BLOCK) ? n : BLOCK;
+			int written {0};
+			for (std::size_t i = 0; i < block; ++i) {
+				if (in[i].valid) {
+					value[carried + written] = in[i].value;
+					valid[carried + written] = true;
+					++written;
+				}
+				out[i] = stencil(window(carried + written - 1));
+			}
+			carry(written);
+			in += block;
+			out += block;
+			n -= block;
+		}
+	}
+
+};
+
+#endif /* HLS_SYNTHESIS */
+
+#endif /* LIB_HLSBLOCK_HPP_ */
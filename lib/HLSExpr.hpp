@@ -0,0 +1,96 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_HLSEXPR_HPP_
+#define LIB_HLSEXPR_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+// Virtual stream of an expression over HLSVar buffers. The expression is given as
+// callable F(int shift), which reads its source buffers at offset(j+shift).
+// offset(k) retimes the expression onto the source buffers by evaluating it with
+// shift k, so no intermediate HLSVar buffer is materialised. The source buffers have
+// to cover the shifted offsets, and each distinct offset instantiates the arithmetic
+// of the expression once. This only saves area for expressions cheaper than their
+// delay line, like the sum of two taps, for a stencil use HLSDelayLine.
+template<typename F>
+class HLSExpr {
+private:
+	F expression;
+
+public:
+	using token_type = decltype(expression(0));
+
+	constexpr HLSExpr(F expression_param) : expression {expression_param} {};
+
+	token_type offset(int offset_val) const {
+		return expression(offset_val);
+	}
+
+	operator token_type() const {
+		return (*this).offset(0);
+	}
+
+};
+
+template<typename F>
+HLSExpr<F> make_hls_expr(F expression) {
+	return HLSExpr<F>(expression);
+}
+
+// Delay line of an expression, which is evaluated once per invocation and assigned as
+// token. All offsets share that evaluation: offset(MAX_OFFSET) is the stored token of
+// the last assignment, the older offsets are the MAX_OFFSET-MIN_OFFSET valid tokens
+// before it, as many registers as an HLSVar over the same offsets. Compared to offsets
+// of an HLSExpr, the arithmetic is built once and the source buffers keep their size.
+// A valid token moves into the line with the next assignment, and offset(MAX_OFFSET)
+// is invalid after an invalid token, so a stencil over the line has no valid output
+// without a new sample instead of repeating the last one.
+template<typename T, int MAX_OFFSET=0, int MIN_OFFSET=0>
+class HLSDelayLine {
+private:
+	constexpr static int maximal_offset = (MAX_OFFSET<0) ? 0 : MAX_OFFSET;
+	constexpr static int minimal_offset = (MIN_OFFSET>0) ? 0 : (-1)*MIN_OFFSET;
+	constexpr static int depth = minimal_offset + maximal_offset;
+	constexpr static int line_depth = (depth==0) ? 1 : depth;
+
+	hls_register Token<T> line[line_depth] {};
+	hls_register Token<T> current {};
+
+public:
+
+	template<typename S>
+	Token<T> operator=(const Token<S> & rhs) {
+		if (current.valid) {
+			#pragma unroll
+			for (int i = 0; i < line_depth-1; ++i) {
+				line[i] = line[i+1];
+			}
+			line[line_depth-1] = current;
+		}
+		current = {rhs.value,rhs.valid};
+		return current;
+	}
+
+	Token<T> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+	Token<T> offset(int offset_val) const {
+		return (offset_val == maximal_offset) ? current : line[depth - maximal_offset + offset_val];
+	}
+
+	operator Token<T>() const {
+		return (*this).offset(0);
+	}
+
+};
+
+#endif /* LIB_HLSEXPR_HPP_ */
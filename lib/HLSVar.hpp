@@ -11,6 +11,7 @@
 #include <HLS/ac_int.h>
 #include <HLS/ac_fixed.h>
 #include "Token.hpp"
+#include "RangeAnalysis.hpp"
 
 template<typename T, int MAX_OFFSET=0, int MIN_OFFSET=0>
 class HLSVar {
@@ -46,16 +47,25 @@ private:
 public:
 
 	auto operator=(const T & rhs) {
+#ifdef HLS_RANGE_ANALYSIS
+		range_analysis::record<T>(this, rhs);
+#endif
 		return (*this)(rhs);
 	}
 
 	template<typename S,int A,int B>
 	auto operator=(const HLSVar<S,A,B> & rhs) {
+#ifdef HLS_RANGE_ANALYSIS
+		range_analysis::record<T>(this, rhs.offset(0));
+#endif
 		return (*this)({rhs.offset(0).value,rhs.offset(0).valid});
 	}
 
 	template<typename S>
 	auto operator=(const Token<S> & rhs) {
+#ifdef HLS_RANGE_ANALYSIS
+		range_analysis::record<T>(this, rhs); // before the conversion to T, which may wrap
+#endif
 		return (*this)({rhs.value,rhs.valid});
 	}
 
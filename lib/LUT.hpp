@@ -0,0 +1,131 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_LUT_HPP_
+#define LIB_LUT_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include <utility>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+namespace lut_detail {
+
+// width, fraction bits and sign of an output type, the ROM stores its raw words
+template<typename T_OUT>
+struct Format;
+
+template<int W, bool S>
+struct Format<ac_int<W,S>> {
+	static constexpr int width = W;
+	static constexpr int fraction_bits = 0;
+	static constexpr bool is_signed = S;
+	static ac_int<W,S> from_word(const ac_int<W,S> & word) { return word; }
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct Format<ac_fixed<W,I,S,Q,O>> {
+	static constexpr int width = W;
+	static constexpr int fraction_bits = W - I;
+	static constexpr bool is_signed = S;
+	static ac_fixed<W,I,S,Q,O> from_word(const ac_int<W,S> & word) {
+		ac_fixed<W,I,S,Q,O> value;
+		value.set_slc(0, word);
+		return value;
+	}
+};
+
+constexpr double power_of_two(int exponent) {
+	double power {1.0};
+	for (int i = 0; i < exponent; ++i) { power *= 2.0; }
+	for (int i = 0; i > exponent; --i) { power /= 2.0; }
+	return power;
+}
+
+// raw word of value in T_OUT, rounded to the nearest step and saturated to the range
+template<typename T_OUT>
+constexpr long long quantise(double value) {
+	using format = Format<T_OUT>;
+	const long long min = format::is_signed ? -(1LL << (format::width - 1)) : 0;
+	const long long max = format::is_signed ? (1LL << (format::width - 1)) - 1 : (1LL << format::width) - 1;
+	const double scaled = value * power_of_two(format::fraction_bits) + 0.5;
+	if (scaled <= static_cast<double>(min)) {
+		return min;
+	}
+	if (scaled >= static_cast<double>(max)) {
+		return max;
+	}
+	const long long truncated = static_cast<long long>(scaled);
+	return (static_cast<double>(truncated) > scaled) ? truncated - 1 : truncated;
+}
+
+// constant table of the raw T_OUT words of F sampled at MIN, MIN+STEP, MIN+2*STEP, ...,
+// the array is initialised at compile-time and implemented as ROM
+template<typename T_OUT, typename F, long long MIN, long long STEP, typename SEQUENCE>
+struct Rom;
+
+template<typename T_OUT, typename F, long long MIN, long long STEP, int... K>
+struct Rom<T_OUT, F, MIN, STEP, std::integer_sequence<int, K...>> {
+	using word = ac_int<Format<T_OUT>::width, Format<T_OUT>::is_signed>;
+	static constexpr word table[sizeof...(K)] {word(quantise<T_OUT>(static_cast<double>(F{}(MIN + K * STEP))))...};
+};
+
+template<typename T_OUT, typename F, long long MIN, long long STEP, int... K>
+constexpr typename Rom<T_OUT, F, MIN, STEP, std::integer_sequence<int, K...>>::word
+	Rom<T_OUT, F, MIN, STEP, std::integer_sequence<int, K...>>::table[sizeof...(K)];
+
+}
+
+// Lookup table node for a nonlinear function F over the full range of the ac_int input
+// type. F is a literal type with a constexpr operator()(long long) const, the output
+// type is an ac_int or ac_fixed type. With less ADDRESS_BITS than input bits, the upper
+// input bits address the table and the lower bits interpolate linearly between two
+// neighbouring entries (INTERPOLATE) or are truncated. The last interpolation entry is F
+// one step past the largest input, it saturates to T_OUT like every entry, so that the
+// top interval stays monotonic if F leaves the output range there.
+template<typename T_IN, typename T_OUT, typename F, int ADDRESS_BITS = T_IN::width, bool INTERPOLATE = (ADDRESS_BITS < T_IN::width)>
+class LUT {
+private:
+	constexpr static int input_width = T_IN::width;
+	constexpr static bool input_signed = T_IN::sign;
+	constexpr static int fraction_bits = input_width - ADDRESS_BITS;
+	constexpr static int fraction_width = (fraction_bits > 0) ? fraction_bits : 1;
+	constexpr static long long minimal_input = input_signed ? -(1LL << (input_width - 1)) : 0;
+	constexpr static int table_size = (1 << ADDRESS_BITS) + (INTERPOLATE ? 1 : 0);
+
+	static_assert(ADDRESS_BITS > 0 && ADDRESS_BITS <= input_width, "LUT address bits out of input range");
+	static_assert(!INTERPOLATE || fraction_bits > 0, "LUT interpolation needs less address bits than input bits");
+
+	using rom = lut_detail::Rom<T_OUT, F, minimal_input, (1LL << fraction_bits), std::make_integer_sequence<int, table_size>>;
+
+public:
+
+	Token<T_OUT> operator()(const Token<T_IN> & input) const {
+		// offset binary, so that table entries are ordered by the input value
+		ac_int<input_width,false> index = input.value;
+		if (input_signed) {
+			index ^= (ac_int<input_width,false>(1) << (input_width - 1));
+		}
+		const ac_int<ADDRESS_BITS,false> address = index.template slc<ADDRESS_BITS>(fraction_bits);
+		T_OUT result = lut_detail::Format<T_OUT>::from_word(rom::table[address.to_uint()]);
+		if (INTERPOLATE) {
+			const ac_int<fraction_width,false> fraction = index.template slc<fraction_width>(0);
+			const T_OUT next = lut_detail::Format<T_OUT>::from_word(rom::table[address.to_uint() + 1]);
+			result = result + (((next - result) * fraction) >> fraction_bits);
+		}
+		return {result, input.valid};
+	}
+
+	template<int A, int B>
+	Token<T_OUT> operator()(const HLSVar<T_IN,A,B> & input) const {
+		return (*this)(input.offset(0));
+	}
+
+};
+
+#endif /* LIB_LUT_HPP_ */
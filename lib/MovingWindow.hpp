@@ -0,0 +1,156 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_MOVINGWINDOW_HPP_
+#define LIB_MOVINGWINDOW_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+// Delay line of N tokens in block RAM. In contrast to HLSVar, only the token that
+// leaves the line is accessible, so the line is a circular buffer with one read and
+// one write per invocation instead of a shift register chain. As for HLSVar, invalid
+// tokens are not shifted in.
+template<typename T, int N>
+class DelayLine {
+private:
+	hls_memory Token<T> ring[N];
+	int position {0};
+
+public:
+
+	// returns the token delayed by N valid tokens
+	Token<T> operator=(const Token<T> & rhs) {
+		Token<T> departing = ring[position];
+		if (rhs.valid) {
+			ring[position] = rhs;
+			position = (position == N-1) ? 0 : position+1;
+			return departing;
+		}
+		return {departing.value,false};
+	}
+
+	Token<T> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+};
+
+namespace moving_window_detail {
+
+// running sum of the squared samples, empty without the variance
+template<typename ACC, bool VARIANCE>
+struct SumOfSquares {
+	hls_register ACC value {0};
+
+	// the samples are widened to ACC before they are squared, the full width square is
+	// quantised to ACC
+	void update(const ACC & sample, const ACC & oldest) {
+		value = value + ACC(sample * sample) - ACC(oldest * oldest);
+	}
+};
+
+template<typename ACC>
+struct SumOfSquares<ACC,false> {
+	void update(const ACC &, const ACC &) {}
+};
+
+}
+
+// Sliding window sum, mean and optionally variance over the last N valid samples with
+// constant cost per sample: the newest sample is added and the oldest one, read back
+// from a DelayLine, is subtracted. Samples are quantised to the accumulator type ACC
+// before they enter the delay line and, with VARIANCE, the squares are quantised to
+// ACC before they are added or subtracted, so exactly the value that was added is
+// subtracted later. With an ac_int or ac_fixed accumulator the sums are exact and do
+// not drift, also for float input streams. Only with VARIANCE the sum of squares and
+// its two multipliers are built, ACC has to hold N times the squared maximum sample.
+template<typename T, int N, typename ACC, bool VARIANCE = false>
+class MovingWindow {
+private:
+	DelayLine<ACC,N> delay_line;
+	hls_register ACC window_sum {0};
+	moving_window_detail::SumOfSquares<ACC,VARIANCE> window_sum_of_squares;
+	int sample_count {0};
+
+	void insert(const ACC & sample) {
+		Token<ACC> departing = (delay_line = sample);
+		const ACC oldest = departing.valid ? departing.value : ACC(0);
+		window_sum = window_sum + sample - oldest;
+		window_sum_of_squares.update(sample, oldest);
+		if (sample_count < N) {
+			++sample_count;
+		}
+	}
+
+public:
+
+	// returns the window sum, valid if a new sample completed a filled window
+	Token<ACC> operator=(const T & rhs) {
+		(*this).insert(ACC(rhs));
+		return (*this).sum();
+	}
+
+	template<typename S>
+	Token<ACC> operator=(const Token<S> & rhs) {
+		if (rhs.valid) {
+			(*this).insert(ACC(rhs.value));
+		}
+		return {window_sum, rhs.valid && sample_count == N};
+	}
+
+	template<typename S,int A,int B>
+	Token<ACC> operator=(const HLSVar<S,A,B> & rhs) {
+		return (*this) = rhs.offset(0);
+	}
+
+	// valid as soon as the window is filled with N valid samples
+	Token<ACC> sum() const {
+		return {window_sum, sample_count == N};
+	}
+
+	Token<ACC> mean() const {
+		return {window_sum / N, sample_count == N};
+	}
+
+	Token<ACC> variance() const {
+		static_assert(VARIANCE, "the variance needs MovingWindow<T,N,ACC,true>");
+		return {(window_sum_of_squares.value * N - window_sum * window_sum) / (N * N), sample_count == N};
+	}
+
+};
+
+// CIC-style smoother: STAGES cascaded moving sums of length N, the output is the sum
+// over the last stage and has the gain N^STAGES
+template<typename T, int N, int STAGES, typename ACC>
+class CascadedMovingSum {
+private:
+	MovingWindow<T,N,ACC> first_stage;
+	MovingWindow<ACC,N,ACC> stage[(STAGES > 1) ? STAGES-1 : 1];
+	Token<ACC> output;
+
+public:
+
+	template<typename S>
+	Token<ACC> operator=(const S & rhs) {
+		output = (first_stage = rhs);
+		#pragma unroll
+		for (int i = 0; i < STAGES-1; ++i) {
+			output = (stage[i] = output);
+		}
+		return output;
+	}
+
+	Token<ACC> sum() const {
+		return output;
+	}
+
+};
+
+#endif /* LIB_MOVINGWINDOW_HPP_ */
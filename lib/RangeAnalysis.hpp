@@ -0,0 +1,255 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_RANGEANALYSIS_HPP_
+#define LIB_RANGEANALYSIS_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+
+// Dynamic range analysis of HLSVar streams in the emulation. Built with
+// -DHLS_RANGE_ANALYSIS (make range), every valid token assigned to an HLSVar that was
+// named with HLS_RANGE_NAME(var) is recorded before its conversion to the declared
+// type. The +, -, * and / of Token expressions carry the value without the wrap-around
+// of their operand type (Token.hpp), so a wrap in the expression is recorded as the
+// exact value as well. report() prints per node the min/max, the declared type, the number of values
+// outside of the declared range, which wrap in the assignment, and the minimal type,
+// which holds every recorded value without overflow or rounding. The histogram counts the samples by the integer bits of their
+// magnitude, which shows how many samples a narrower saturating type would clip.
+// Without HLS_RANGE_ANALYSIS, HLS_RANGE_NAME expands to nothing and HLSVar is unchanged.
+#if defined(HLS_RANGE_ANALYSIS) && !defined(HLS_SYNTHESIS)
+#define HLS_RANGE_NAME(var) range_analysis::name(&(var),__func__,#var)
+#else
+#define HLS_RANGE_NAME(var) ((void)0)
+#endif
+
+#ifndef HLS_SYNTHESIS
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace range_detail {
+
+// width, integer and fraction bits of a declared type
+template<typename T>
+struct NumberFormat {
+	static constexpr bool is_signed = std::numeric_limits<T>::is_signed;
+	static constexpr bool is_integer = std::numeric_limits<T>::is_integer;
+	static constexpr int width = std::numeric_limits<T>::digits + (is_integer && is_signed ? 1 : 0);
+	static constexpr int fraction_bits = is_integer ? 0 : std::numeric_limits<T>::digits;
+	static double min_value() { return static_cast<double>(std::numeric_limits<T>::lowest()); }
+	static double max_value() { return static_cast<double>(std::numeric_limits<T>::max()); }
+	static std::string name() {
+		std::ostringstream os;
+		os << (is_integer ? (is_signed ? "int" : "uint") : "float") << (is_integer ? width : int(8*sizeof(T)));
+		return os.str();
+	}
+};
+
+template<int W, bool S>
+struct NumberFormat<ac_int<W,S>> {
+	static constexpr bool is_signed = S;
+	static constexpr bool is_integer = true;
+	static constexpr int width = W;
+	static constexpr int fraction_bits = 0;
+	static double min_value() { return S ? -std::ldexp(1.0,W-1) : 0.0; }
+	static double max_value() { return std::ldexp(1.0,S ? W-1 : W) - 1.0; }
+	static std::string name() {
+		std::ostringstream os;
+		os << "ac_int<" << W << "," << (S ? "true" : "false") << ">";
+		return os.str();
+	}
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct NumberFormat<ac_fixed<W,I,S,Q,O>> {
+	static constexpr bool is_signed = S;
+	static constexpr bool is_integer = false;
+	static constexpr int width = W;
+	static constexpr int fraction_bits = W - I;
+	static double min_value() { return S ? -std::ldexp(1.0,I-1) : 0.0; }
+	static double max_value() { return std::ldexp(1.0,S ? I-1 : I) - std::ldexp(1.0,I-W); }
+	static std::string name() {
+		std::ostringstream os;
+		os << "ac_fixed<" << W << "," << I << "," << (S ? "true" : "false") << ">";
+		return os.str();
+	}
+};
+
+template<int W, bool S>
+double to_double(const ac_int<W,S> & value) { return value.to_double(); }
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+double to_double(const ac_fixed<W,I,S,Q,O> & value) { return value.to_double(); }
+
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+double to_double(const T & value) { return static_cast<double>(value); }
+
+// smallest number of integer bits I with value in [-2^(I-1),2^(I-1)) or [0,2^I)
+inline int integer_bits(double value, bool is_signed, int lowest) {
+	int bits = lowest;
+	while (bits < 128) {
+		const double bound = std::ldexp(1.0, is_signed ? bits-1 : bits);
+		if (value < bound && (!is_signed || value >= -bound)) {
+			break;
+		}
+		++bits;
+	}
+	return bits;
+}
+
+// smallest number of fraction bits, which represents value exactly, at most limit
+inline int fraction_bits(double value, int limit) {
+	int bits = 0;
+	while (bits < limit && std::ldexp(value,bits) != std::floor(std::ldexp(value,bits))) {
+		++bits;
+	}
+	return bits;
+}
+
+}
+
+namespace range_analysis {
+
+struct NodeRange {
+	std::string name;
+	std::string declared_type;
+	bool declared_integer {true};
+	long samples {0};
+	long overflows {0}; // values outside of the range of the declared type
+	double min {0.0};
+	double max {0.0};
+	int fraction_bits {0};
+	std::map<int,long> histogram; // integer bits of the magnitude, samples
+
+	bool is_signed() const { return min < 0.0; }
+
+	// smallest integer bits, which hold min and max in a type at least one bit wide
+	int integer_bits() const {
+		const int lowest = 1 - fraction_bits;
+		const int for_min = range_detail::integer_bits(min, is_signed(), lowest);
+		const int for_max = range_detail::integer_bits(max, is_signed(), lowest);
+		return (for_min > for_max) ? for_min : for_max;
+	}
+
+	std::string recommended_type() const {
+		std::ostringstream os;
+		const int width = integer_bits() + fraction_bits;
+		const char * sign = is_signed() ? "true" : "false";
+		if (fraction_bits == 0 && declared_integer) {
+			os << "ac_int<" << width << "," << sign << ">";
+		} else {
+			os << "ac_fixed<" << width << "," << integer_bits() << "," << sign << ">";
+		}
+		return os.str();
+	}
+};
+
+struct Registry {
+	std::map<const void*,std::string> names;
+	std::map<std::string,NodeRange> nodes;
+};
+
+inline Registry & registry() {
+	static Registry instance;
+	return instance;
+}
+
+// names an HLSVar for the analysis, the node is reported as function::variable
+inline void name(const void * var, const char * function, const char * variable) {
+	registry().names.emplace(var, std::string(function) + "::" + variable);
+}
+
+// records a value assigned to the named variable var of the declared type T, unnamed
+// variables are ignored
+template<typename T, typename S>
+void record(const void * var, const S & value) {
+	Registry & reg = registry();
+	const auto named = reg.names.find(var);
+	if (named == reg.names.end()) {
+		return;
+	}
+	using format = range_detail::NumberFormat<T>;
+	const double sample = range_detail::to_double(value);
+	NodeRange & node = reg.nodes[named->second];
+	if (node.samples == 0) {
+		node.name = named->second;
+		node.declared_type = format::name();
+		node.declared_integer = format::is_integer;
+		node.min = sample;
+		node.max = sample;
+	}
+	node.min = (sample < node.min) ? sample : node.min;
+	node.max = (sample > node.max) ? sample : node.max;
+	if (sample < format::min_value() || sample > format::max_value()) {
+		++node.overflows;
+	}
+	const int sample_fraction_bits = range_detail::fraction_bits(sample, format::fraction_bits);
+	node.fraction_bits = (sample_fraction_bits > node.fraction_bits) ? sample_fraction_bits : node.fraction_bits;
+	++node.histogram[range_detail::integer_bits(std::fabs(sample), false, 1 - format::fraction_bits)];
+	++node.samples;
+}
+
+// a token of a Token expression is recorded with its value before the wrap-around in
+// the expression
+template<typename T, typename S>
+void record(const void * var, const Token<S> & token) {
+	if (token.valid) {
+#ifdef HLS_TOKEN_EXACT
+		record<T>(var, token.exact_value());
+#else
+		record<T>(var, token.value);
+#endif
+	}
+}
+
+// clears the recorded ranges, the names stay registered
+inline void reset() {
+	registry().nodes.clear();
+}
+
+inline std::vector<NodeRange> nodes() {
+	std::vector<NodeRange> result;
+	for (const auto & node : registry().nodes) {
+		result.push_back(node.second);
+	}
+	return result;
+}
+
+// one typedef per node to paste back into the component, with the recorded range
+inline void report(std::ostream & os, bool histogram = false) {
+	for (const NodeRange & node : nodes()) {
+		std::string type_name = node.name;
+		type_name.replace(type_name.find("::"), 2, "_");
+		os << "using " << type_name << "_t = " << node.recommended_type() << "; // declared "
+		   << node.declared_type << ", " << node.samples << " samples in [" << node.min << "," << node.max << "]";
+		if (node.overflows > 0) {
+			os << ", OVERFLOW of the declared type in " << node.overflows << " samples";
+		}
+		os << std::endl;
+		if (histogram) {
+			os << "//   magnitude integer bits:samples";
+			for (const auto & bin : node.histogram) {
+				os << " " << bin.first << ":" << bin.second;
+			}
+			os << std::endl;
+		}
+	}
+}
+
+}
+
+#endif /* HLS_SYNTHESIS */
+
+#endif /* LIB_RANGEANALYSIS_HPP_ */
@@ -0,0 +1,226 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_RANKORDER_HPP_
+#define LIB_RANKORDER_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+namespace rank_order_detail {
+
+constexpr int clog2(int value) {
+	int bits {0};
+	while ((1 << bits) < value) { ++bits; }
+	return bits;
+}
+
+// Batcher's merge exchange sorting network for N inputs (Knuth, TAOCP Vol. 3,
+// Algorithm 5.2.2M), the comparator list is generated at compile-time
+template<int N>
+struct SortingNetwork {
+	constexpr static int max_comparators = (N < 2) ? 1 : N * N;
+	int lower[max_comparators];
+	int upper[max_comparators];
+	int size;
+	constexpr SortingNetwork() : lower{}, upper{}, size{0} {
+		const int t = clog2(N);
+		for (int p = (N < 2) ? 0 : (1 << (t - 1)); p > 0; p >>= 1) {
+			int q = 1 << (t - 1);
+			int r = 0;
+			int d = p;
+			while (true) {
+				for (int i = 0; i < N - d; ++i) {
+					if ((i & p) == r) {
+						lower[size] = i;
+						upper[size] = i + d;
+						++size;
+					}
+				}
+				if (q == p) { break; }
+				d = q - p;
+				q >>= 1;
+				r = p;
+			}
+		}
+	}
+};
+
+template<int N>
+constexpr SortingNetwork<N> sorting_network {};
+
+template<int N, typename T>
+void sort(T (&values)[N]) {
+	constexpr auto & network = sorting_network<N>;
+	#pragma unroll
+	for (int c = 0; c < network.size; ++c) {
+		const T lower = values[network.lower[c]];
+		const T upper = values[network.upper[c]];
+		const bool swap = upper < lower;
+		values[network.lower[c]] = swap ? upper : lower;
+		values[network.upper[c]] = swap ? lower : upper;
+	}
+}
+
+}
+
+// Rank order filter over the whole window of an HLSVar, K=0 selects the smallest value.
+// Comparators of the sorting network that do not contribute to rank K are removed
+// by the compiler. The result is valid when every token of the window is valid.
+template<int K, typename T, int A, int B>
+Token<T> rank_order(const HLSVar<T,A,B> & window) {
+	constexpr int lowest_offset = (B > 0) ? 0 : B;
+	constexpr int highest_offset = (A < 0) ? 0 : A;
+	constexpr int N = highest_offset - lowest_offset + 1;
+	static_assert(K >= 0 && K < N, "rank out of window range");
+	T values[N];
+	bool valid {true};
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		values[i] = window.offset(lowest_offset + i).value;
+		valid = valid && window.offset(lowest_offset + i).valid;
+	}
+	rank_order_detail::sort<N>(values);
+	return {values[K], valid};
+}
+
+template<typename T, int A, int B>
+Token<T> median(const HLSVar<T,A,B> & window) {
+	constexpr int N = ((A < 0) ? 0 : A) - ((B > 0) ? 0 : B) + 1;
+	return rank_order<N / 2>(window);
+}
+
+// windowed minimum (erosion) and maximum (dilation) as balanced comparator trees
+template<typename T, int A, int B>
+Token<T> window_min(const HLSVar<T,A,B> & window) {
+	constexpr int lowest_offset = (B > 0) ? 0 : B;
+	constexpr int highest_offset = (A < 0) ? 0 : A;
+	constexpr int N = highest_offset - lowest_offset + 1;
+	Token<T> values[N];
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		values[i] = window.offset(lowest_offset + i);
+	}
+	#pragma unroll
+	for (int stride = 1; stride < N; stride *= 2) {
+		#pragma unroll
+		for (int i = 0; i + stride < N; i += 2 * stride) {
+			const bool select_upper = values[i + stride].value < values[i].value;
+			values[i] = Token<T>{select_upper ? values[i + stride].value : values[i].value, values[i].valid && values[i + stride].valid};
+		}
+	}
+	return values[0];
+}
+
+template<typename T, int A, int B>
+Token<T> window_max(const HLSVar<T,A,B> & window) {
+	constexpr int lowest_offset = (B > 0) ? 0 : B;
+	constexpr int highest_offset = (A < 0) ? 0 : A;
+	constexpr int N = highest_offset - lowest_offset + 1;
+	Token<T> values[N];
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		values[i] = window.offset(lowest_offset + i);
+	}
+	#pragma unroll
+	for (int stride = 1; stride < N; stride *= 2) {
+		#pragma unroll
+		for (int i = 0; i + stride < N; i += 2 * stride) {
+			const bool select_upper = values[i].value < values[i + stride].value;
+			values[i] = Token<T>{select_upper ? values[i + stride].value : values[i].value, values[i].valid && values[i + stride].valid};
+		}
+	}
+	return values[0];
+}
+
+// Rank order filter for large windows. Instead of sorting the whole window for every
+// sample, the window is kept sorted: the oldest sample is removed and the new sample
+// is inserted with one comparator per window position, so the cost grows linearly
+// with N and the dependency depth stays constant.
+template<typename T, int N>
+class SlidingRankOrder {
+private:
+	using age_t = ac_int<rank_order_detail::clog2(N) + 1,false>;
+
+	hls_register Token<T> sorted[N];
+	hls_register age_t age[N];
+
+	void insert(const Token<T> & input_val) {
+		Token<T> remaining[N];
+		age_t remaining_age[N];
+		bool removed {false};
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			removed = removed || (age[i] == N - 1);
+			const int source = (removed && i + 1 < N) ? i + 1 : i;
+			remaining[i] = sorted[source];
+			remaining_age[i] = age[source] + 1;
+		}
+		bool lower[N];
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			lower[i] = (i < N - 1) && (remaining[i].value < input_val.value);
+		}
+		#pragma unroll
+		for (int i = N - 1; i >= 0; --i) {
+			if (lower[i]) {
+				sorted[i] = remaining[i];
+				age[i] = remaining_age[i];
+			} else if (i == 0 || lower[i - 1]) {
+				sorted[i] = input_val;
+				age[i] = 0;
+			} else {
+				sorted[i] = remaining[i - 1];
+				age[i] = remaining_age[i - 1];
+			}
+		}
+	}
+
+public:
+
+	SlidingRankOrder() {
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			age[i] = i;
+		}
+	}
+
+	void operator=(const T & rhs) {
+		(*this).insert({rhs,true});
+	}
+
+	template<typename S>
+	void operator=(const Token<S> & rhs) {
+		if (rhs.valid) {
+			(*this).insert({rhs.value,rhs.valid});
+		}
+	}
+
+	template<typename S,int A,int B>
+	void operator=(const HLSVar<S,A,B> & rhs) {
+		(*this) = rhs.offset(0);
+	}
+
+	// valid as soon as N valid samples were streamed in
+	Token<T> rank(int k) const {
+		bool valid {true};
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			valid = valid && sorted[i].valid;
+		}
+		return {sorted[k].value, valid};
+	}
+
+	Token<T> median() const {
+		return (*this).rank(N / 2);
+	}
+
+};
+
+#endif /* LIB_RANKORDER_HPP_ */
@@ -0,0 +1,129 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_REORDERBUFFER_HPP_
+#define LIB_REORDERBUFFER_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+enum class ReorderMode { transpose, raster_to_tile, tile_to_raster };
+
+// Ping-pong frame buffer in block RAM, which reorders a stream of ROWS x COLS frames.
+// Valid tokens are written in arrival order into one bank, while the other, completely
+// filled bank is read in the permuted order, one token per invocation. The output of a
+// frame starts one frame after its first token, and the stream keeps II=1 as long as
+// the buffer is invoked once per input token. The read position is kept in row, column
+// and tile counters that wrap by comparison, so the read path has no dividers also for
+// sizes that are not powers of two.
+//   transpose:      raster ROWS x COLS in, raster COLS x ROWS out
+//   raster_to_tile: raster in, TILE_ROWS x TILE_COLS tiles out, each tile in raster order
+//   tile_to_raster: tiles in, raster out
+template<typename T, int ROWS, int COLS, ReorderMode MODE = ReorderMode::transpose, int TILE_ROWS = 1, int TILE_COLS = 1>
+class ReorderBuffer {
+private:
+	constexpr static int frame_size = ROWS * COLS;
+	constexpr static int tile_size = TILE_ROWS * TILE_COLS;
+	constexpr static int tiles_per_row = COLS / TILE_COLS;
+	constexpr static int tiles_per_col = ROWS / TILE_ROWS;
+
+	static_assert(ROWS % TILE_ROWS == 0 && COLS % TILE_COLS == 0, "frame is not a multiple of the tile size");
+
+	hls_memory T bank[2][frame_size];
+	bool bank_full[2] {false,false};
+	int write_bank {0};
+	int write_index {0};
+	int read_bank {0};
+	int read_index {0};
+
+	// output position as tile and position in the tile, for transpose the output column
+	// in tile_row and the output row in tile_col
+	int tile_row {0};
+	int tile_col {0};
+	int in_row {0};
+	int in_col {0};
+
+	// steps a counter and wraps it by comparison, true on the wrap
+	static bool advance(int & counter, int limit) {
+		const bool wrap = (counter == limit-1);
+		counter = wrap ? 0 : counter+1;
+		return wrap;
+	}
+
+	// steps the output position, the faster counters carry into the slower ones
+	void step_read_position() {
+		if (MODE == ReorderMode::transpose) {
+			if (advance(tile_row, ROWS)) {
+				advance(tile_col, COLS);
+			}
+		} else if (MODE == ReorderMode::raster_to_tile) {
+			if (advance(in_col, TILE_COLS) && advance(in_row, TILE_ROWS) && advance(tile_col, tiles_per_row)) {
+				advance(tile_row, tiles_per_col);
+			}
+		} else {
+			if (advance(in_col, TILE_COLS) && advance(tile_col, tiles_per_row) && advance(in_row, TILE_ROWS)) {
+				advance(tile_row, tiles_per_col);
+			}
+		}
+	}
+
+	// position in the written frame of the token at the output position, the products
+	// are with constants
+	int read_address() const {
+		if (MODE == ReorderMode::transpose) {
+			return tile_row * COLS + tile_col;
+		} else if (MODE == ReorderMode::raster_to_tile) {
+			return (tile_row * TILE_ROWS + in_row) * COLS + tile_col * TILE_COLS + in_col;
+		} else {
+			return (tile_row * tiles_per_row + tile_col) * tile_size + in_row * TILE_COLS + in_col;
+		}
+	}
+
+public:
+
+	// writes the input token and returns the next token of the reordered stream
+	template<typename S>
+	Token<T> operator=(const Token<S> & rhs) {
+		if (rhs.valid) {
+			bank[write_bank][write_index] = rhs.value;
+			if (write_index == frame_size-1) {
+				bank_full[write_bank] = true;
+				write_bank = 1 - write_bank;
+				write_index = 0;
+			} else {
+				++write_index;
+			}
+		}
+		Token<T> output {0,false};
+		if (bank_full[read_bank]) {
+			output = Token<T>{bank[read_bank][read_address()],true};
+			step_read_position();
+			if (read_index == frame_size-1) {
+				bank_full[read_bank] = false;
+				read_bank = 1 - read_bank;
+				read_index = 0;
+			} else {
+				++read_index;
+			}
+		}
+		return output;
+	}
+
+	Token<T> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+	template<typename S,int A,int B>
+	Token<T> operator=(const HLSVar<S,A,B> & rhs) {
+		return (*this) = rhs.offset(0);
+	}
+
+};
+
+#endif /* LIB_REORDERBUFFER_HPP_ */
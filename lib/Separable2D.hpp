@@ -0,0 +1,86 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_SEPARABLE2D_HPP_
+#define LIB_SEPARABLE2D_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+#include "ReorderBuffer.hpp"
+
+// One dimensional stencil pass along the lines of a raster stream with LENGTH samples
+// per line. Kernel is a function object with a static constexpr int radius and a
+// templated operator()(const W & stream) reading offset(-radius) to offset(+radius).
+// Offsets outside of the line of the center sample read as valid zero tokens.
+template<typename T, int LENGTH, typename Kernel>
+class LinePass {
+private:
+	constexpr static int radius = Kernel::radius;
+
+	static_assert(radius < LENGTH, "kernel is wider than a line");
+
+	struct Window {
+		const HLSVar<T,radius,-radius> & stream;
+		const int center_column;
+		Token<T> offset(int offset_val) const {
+			const Token<T> token = stream.offset(offset_val);
+			const bool inside = (center_column + offset_val >= 0) && (center_column + offset_val < LENGTH);
+			return inside ? token : Token<T>{0,true};
+		}
+	};
+
+	HLSVar<T,radius,-radius> stream;
+	int center_column {LENGTH - radius - 1};
+
+public:
+
+	// returns the filtered center sample, valid only for a new valid input token
+	template<typename S>
+	Token<T> operator=(const Token<S> & rhs) {
+		stream = rhs;
+		if (rhs.valid) {
+			center_column = (center_column == LENGTH-1) ? 0 : center_column+1;
+		}
+		const Token<T> filtered = Kernel{}(Window{stream,center_column});
+		return {filtered.value, filtered.valid && rhs.valid};
+	}
+
+};
+
+// Separable 2D filter of a raster stream of ROWS x COLS frames. The row pass filters
+// the raster stream, a ReorderBuffer transposes the frame, the column pass filters the
+// transposed stream along its lines and a second ReorderBuffer restores the raster
+// order. A K x K kernel costs 2K instead of K^2 multiply-adds per pixel, for the
+// latency of two frames and two ping-pong frame buffers. The frame border is zero
+// padded. To flush the last frame, two more frames have to be streamed in.
+template<typename T, int ROWS, int COLS, typename RowKernel, typename ColKernel>
+class Separable2D {
+private:
+	LinePass<T,COLS,RowKernel> row_pass;
+	ReorderBuffer<T,ROWS,COLS,ReorderMode::transpose> transpose;
+	LinePass<T,ROWS,ColKernel> column_pass;
+	ReorderBuffer<T,COLS,ROWS,ReorderMode::transpose> transpose_back;
+
+public:
+
+	template<typename S>
+	Token<T> operator=(const Token<S> & rhs) {
+		const Token<T> row_filtered = (row_pass = rhs);
+		const Token<T> transposed = (transpose = row_filtered);
+		const Token<T> column_filtered = (column_pass = transposed);
+		return (transpose_back = column_filtered);
+	}
+
+	Token<T> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+};
+
+#endif /* LIB_SEPARABLE2D_HPP_ */
@@ -0,0 +1,152 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_STREAMROUTING_HPP_
+#define LIB_STREAMROUTING_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+#include "HLSVar.hpp"
+
+// Nodes to split and join token streams. select, broadcast and demux are
+// combinational and pass the valid bit of the routed token. Merge joins N streams
+// into one at II=1 and queues the tokens that lose the arbitration.
+
+// token a if sel is true, token b otherwise
+template<typename T, typename S>
+Token<T> select(bool sel, const Token<T> & a, const Token<S> & b) {
+	return sel ? a : Token<T>{b.value,b.valid};
+}
+
+// token inputs[index], invalid for an index out of range
+template<typename T, int N>
+Token<T> select(int index, const Token<T> (&inputs)[N]) {
+	Token<T> output {0,false};
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		output = (i == index) ? inputs[i] : output;
+	}
+	return output;
+}
+
+// copies the input token to every output
+template<typename T, int N, typename S>
+void broadcast(const Token<S> & input, Token<T> (&outputs)[N]) {
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		outputs[i] = input;
+	}
+}
+
+template<typename T, int N, typename S, int A, int B>
+void broadcast(const HLSVar<S,A,B> & input, Token<T> (&outputs)[N]) {
+	broadcast(input.offset(0), outputs);
+}
+
+// routes the input token to outputs[index], all other outputs are invalid
+template<typename T, int N, typename S>
+void demux(int index, const Token<S> & input, Token<T> (&outputs)[N]) {
+	#pragma unroll
+	for (int i = 0; i < N; ++i) {
+		outputs[i] = Token<T>{input.value, input.valid && (i == index)};
+	}
+}
+
+enum class MergePolicy { round_robin, priority };
+
+namespace merge_detail {
+
+// bits of an unsigned counter from 0 to max_value
+constexpr int counter_bits(int max_value) {
+	int bits {1};
+	while ((1 << bits) <= max_value) { ++bits; }
+	return bits;
+}
+
+}
+
+// Merges N token streams into one. Each invocation outputs one token, either the oldest
+// queued token or the valid input token of the input chosen by the arbitration:
+//   round_robin: the next input with a token after the one chosen last
+//   priority:    the lowest input index with a token
+// Valid tokens of the other inputs wait in a queue of DEPTH registers per input. A
+// token arriving at a full queue is dropped and sets overflow(), so the summed rate of
+// the inputs has to stay below one token per invocation on average. The fill counters
+// and the round robin pointer are sized to DEPTH and N, and the rotation of the
+// arbitration order wraps by comparison.
+template<typename T, int N, MergePolicy POLICY = MergePolicy::round_robin, int DEPTH = 2>
+class Merge {
+private:
+	using fill_t = ac_int<merge_detail::counter_bits(DEPTH),false>;
+	using index_t = ac_int<merge_detail::counter_bits(N-1),false>;
+	using source_t = ac_int<merge_detail::counter_bits(N-1)+1,true>;
+
+	hls_register T queue[N][DEPTH];
+	fill_t fill[N] {};
+	index_t next {0};
+	source_t last_source {-1};
+	bool overflow_flag {false};
+
+public:
+
+	template<typename S>
+	Token<T> operator=(const Token<S> (&inputs)[N]) {
+		bool pending[N];
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			pending[i] = (fill[i] > 0) || inputs[i].valid;
+		}
+		int winner {-1};
+		#pragma unroll
+		for (int k = N-1; k >= 0; --k) {
+			const int rotated = next.to_int() + k;
+			const int i = (POLICY == MergePolicy::round_robin) ? ((rotated >= N) ? rotated - N : rotated) : k;
+			winner = pending[i] ? i : winner;
+		}
+		Token<T> output {0,false};
+		#pragma unroll
+		for (int i = 0; i < N; ++i) {
+			const bool queued = fill[i] > 0;
+			if (i == winner) {
+				output = Token<T>{queued ? queue[i][0] : T(inputs[i].value), true};
+			}
+			if (i == winner && queued) {
+				#pragma unroll
+				for (int k = 0; k < DEPTH-1; ++k) {
+					queue[i][k] = queue[i][k+1];
+				}
+				--fill[i];
+			}
+			const bool enqueue = inputs[i].valid && (i != winner || queued);
+			if (enqueue && fill[i] < DEPTH) {
+				queue[i][fill[i].to_int()] = inputs[i].value;
+				++fill[i];
+			} else if (enqueue) {
+				overflow_flag = true;
+			}
+		}
+		if (winner >= 0) {
+			last_source = winner;
+			next = (winner == N-1) ? 0 : winner + 1;
+		}
+		return output;
+	}
+
+	// input of the last valid output token
+	int source() const {
+		return last_source.to_int();
+	}
+
+	// true once a token was dropped at a full queue
+	bool overflow() const {
+		return overflow_flag;
+	}
+
+};
+
+#endif /* LIB_STREAMROUTING_HPP_ */
@@ -0,0 +1,83 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef LIB_SYSTOLICFIR_HPP_
+#define LIB_SYSTOLICFIR_HPP_
+
+#include <HLS/hls.h>
+#include <HLS/stdio.h>
+#include <HLS/ac_int.h>
+#include <HLS/ac_fixed.h>
+#include "Token.hpp"
+
+// Systolic FIR filter for long kernels. The coefficients are given in the order of the
+// window offsets of a direct-form stencil over an HLSVar<T,MAX_OFFSET,MIN_OFFSET>, and
+// the output is the weighted sum of that stencil delayed by latency valid samples.
+// Instead of one adder tree over all taps, the partial sum passes a register after
+// every tap, so each stage is one multiply-add. The input is broadcast to segments of
+// FANOUT taps, and a delay line of 2*FANOUT samples between the segments keeps the
+// fanout of each input register at FANOUT taps plus the next delay line. Taps are
+// padded with zero coefficients to a multiple of FANOUT.
+template<typename T, int MAX_OFFSET, int MIN_OFFSET, typename C, typename ACC, int FANOUT = 8>
+class SystolicFIR {
+private:
+	constexpr static int lowest_offset = (MIN_OFFSET > 0) ? 0 : MIN_OFFSET;
+	constexpr static int highest_offset = (MAX_OFFSET < 0) ? 0 : MAX_OFFSET;
+	constexpr static int taps = highest_offset - lowest_offset + 1;
+	constexpr static int segments = (taps + FANOUT - 1) / FANOUT;
+	constexpr static int stages = segments * FANOUT;
+	constexpr static int segment_delay = 2 * FANOUT;
+	constexpr static int input_depth = (segments - 1) * segment_delay + 1;
+
+	static_assert(FANOUT > 0, "fanout has to be positive");
+
+	// coefficient of the chain stage, stage j of segment s is the tap with delay s*FANOUT+FANOUT-1-j
+	C coefficients[stages];
+	hls_register T input_line[input_depth] {};
+	hls_register ACC partial_sum[stages] {};
+	int samples {0};
+
+public:
+
+	// valid samples from an input to the output of the stencil over its window
+	constexpr static int latency = stages - FANOUT + 1;
+
+	template<typename D>
+	SystolicFIR(const D (&coefficients_param)[taps]) {
+		#pragma unroll
+		for (int i = 0; i < stages; ++i) {
+			const int delay = (i / FANOUT) * FANOUT + FANOUT - 1 - (i % FANOUT);
+			coefficients[i] = (delay < taps) ? C(coefficients_param[taps - 1 - delay]) : C(0);
+		}
+	}
+
+	template<typename S>
+	Token<ACC> operator=(const Token<S> & rhs) {
+		if (!rhs.valid) {
+			return Token<ACC>{partial_sum[stages-1],false};
+		}
+		#pragma unroll
+		for (int i = stages-1; i > 0; --i) {
+			const T sample = input_line[(i / FANOUT) * segment_delay];
+			partial_sum[i] = partial_sum[i-1] + coefficients[i] * sample;
+		}
+		partial_sum[0] = coefficients[0] * input_line[0];
+		#pragma unroll
+		for (int i = input_depth-1; i > 0; --i) {
+			input_line[i] = input_line[i-1];
+		}
+		input_line[0] = rhs.value;
+		const bool valid = (samples >= latency + taps - 1);
+		samples = valid ? samples : samples+1;
+		return Token<ACC>{partial_sum[stages-1],valid};
+	}
+
+	Token<ACC> operator=(const T & rhs) {
+		return (*this) = Token<T>{rhs,true};
+	}
+
+};
+
+#endif /* LIB_SYSTOLICFIR_HPP_ */
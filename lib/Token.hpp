@@ -15,10 +15,47 @@
 template<typename T, int A, int B>
 class HLSVar;
 
+// With HLS_RANGE_ANALYSIS, a token of an arithmetic expression carries the value of the
+// expression without the wrap-around of its type, computed from the exact values of its
+// operands, so the range analysis sees the values before they wrap in the expression.
+#if defined(HLS_RANGE_ANALYSIS) && !defined(HLS_SYNTHESIS)
+#define HLS_TOKEN_EXACT
+#include <cmath>
+#include <type_traits>
+
+namespace token_detail {
+
+template<typename T>
+struct is_integer : std::is_integral<T> {};
+
+template<int W, bool S>
+struct is_integer<ac_int<W,S>> : std::true_type {};
+
+template<int W, bool S>
+double to_double(const ac_int<W,S> & value) { return value.to_double(); }
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+double to_double(const ac_fixed<W,I,S,Q,O> & value) { return value.to_double(); }
+
+template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+double to_double(const T & value) { return static_cast<double>(value); }
+
+}
+#endif
+
 template<typename T>
 struct Token {
 	T value {0};
 	bool valid {false};
+#ifdef HLS_TOKEN_EXACT
+	bool has_exact {false};
+	double exact {0.0};
+
+	// value without the wrap-around of the expression that computed the token
+	double exact_value() const {
+		return has_exact ? exact : token_detail::to_double(value);
+	}
+#endif
 	constexpr Token<T>() : value {0}, valid {false} {};
 	constexpr Token<T>(const T value_param,const bool valid_param) : value {value_param}, valid {valid_param} {};
 	constexpr Token<T>(const T value_param) : value {value_param} , valid {true} {};
@@ -29,40 +66,64 @@ struct Token {
 	Token<T> & operator=(const Token<S> & rhs) {
 		(*this).valid = rhs.valid;
 		(*this).value = rhs.value;
+#ifdef HLS_TOKEN_EXACT
+		(*this).has_exact = true;
+		(*this).exact = rhs.exact_value();
+#endif
 		return *this;
 	}
 	template<int A, int B>
 	Token<T> & operator=(const HLSVar<T,A,B> & rhs) {
 		(*this).valid = rhs.offset(0).valid;
 		(*this).value = rhs.offset(0).value;
+#ifdef HLS_TOKEN_EXACT
+		(*this).has_exact = false;
+#endif
 		return *this;
 	}
 };
 
+#ifdef HLS_TOKEN_EXACT
+namespace token_detail {
+
+template<typename T>
+Token<T> with_exact(Token<T> result, double exact) {
+	result.has_exact = true;
+	result.exact = is_integer<T>::value ? std::trunc(exact) : exact;
+	return result;
+}
+
+}
+#define HLS_TOKEN_RESULT(expression, exact_expression) token_detail::with_exact<T>(expression, exact_expression)
+#else
+#define HLS_TOKEN_RESULT(expression, exact_expression) expression
+#endif
+
 template<typename T>
 Token<T> operator+(const Token<T> & lhs, const Token<T> & rhs) {
-	return {lhs.value + rhs.value, lhs.valid && rhs.valid};
+	return HLS_TOKEN_RESULT(Token<T>(lhs.value + rhs.value, lhs.valid && rhs.valid), lhs.exact_value() + rhs.exact_value());
 };
 
 template<typename T>
 Token<T> operator-(const Token<T> & lhs, const Token<T> & rhs) {
-	return {lhs.value - rhs.value, lhs.valid && rhs.valid};
+	return HLS_TOKEN_RESULT(Token<T>(lhs.value - rhs.value, lhs.valid && rhs.valid), lhs.exact_value() - rhs.exact_value());
 };
 
 template<typename T>
 Token<T> operator*(const Token<T> & lhs, const Token<T> & rhs) {
-	return {lhs.value * rhs.value, lhs.valid && rhs.valid};
+	return HLS_TOKEN_RESULT(Token<T>(lhs.value * rhs.value, lhs.valid && rhs.valid), lhs.exact_value() * rhs.exact_value());
 };
 
 template<typename T>
 Token<T> operator/(const Token<T> & lhs, const Token<T> & rhs) {
-	return {lhs.value / rhs.value, lhs.valid && rhs.valid};
+	return HLS_TOKEN_RESULT(Token<T>(lhs.value / rhs.value, lhs.valid && rhs.valid), lhs.exact_value() / rhs.exact_value());
 }
 
 template<typename T, typename S>
 Token<T> operator/(const Token<T> & lhs, const Token<S> & rhs) {
-	return {lhs.value / rhs.value, lhs.valid && rhs.valid};
+	return HLS_TOKEN_RESULT(Token<T>(lhs.value / rhs.value, lhs.valid && rhs.valid), lhs.exact_value() / rhs.exact_value());
 };
 
+#undef HLS_TOKEN_RESULT
 
 #endif /* LIB_TOKEN_HPP_ */
@@ -34,6 +34,35 @@ component uint10 moving_avg_hls (uint10 stream_in) {
 	return result;
 }
 
+component Token<uint10> moving_avg_long(uint10 stream_in) {
+	static MovingWindow<uint10,256,uint36> window;
+	window = stream_in;
+	Token<uint10> avg;
+	avg = window.mean();
+	return avg;
+}
+
+component Token<uint20> moving_variance_long(uint10 stream_in) {
+	static MovingWindow<uint10,100,uint36,true> window;
+	window = stream_in;
+	Token<uint20> variance;
+	variance = window.variance();
+	return variance;
+}
+
+component Token<fixp_40_16> moving_avg_float_long(float stream_in) {
+	static MovingWindow<float,64,fixp_40_16> window;
+	window = stream_in;
+	return window.mean();
+}
+
+component Token<uint10> cic_smoother_adc(uint10 stream_in) {
+	static CascadedMovingSum<uint10,16,3,uint22> smoother;
+	smoother = stream_in;
+	Token<uint22> sum = smoother.sum();
+	return {sum.value >> 12, sum.valid};
+}
+
 //component uint10 moving_avg_RTLMod(uint10 stream_in) {
 //	return moving_avg_rtl(stream_in);
 //}
@@ -61,6 +90,28 @@ component uint10 convol2d (uint10 stream_in) {
 	return result.value;
 }
 
+component Token<uint10> gaussian5x5_separable(uint10 stream_in) {
+	static Separable2D<uint14,GAUSS_ROWS,GAUSS_COLS,binomial5_kernel,binomial5_kernel> gaussian;
+	Token<uint10> result;
+	result = (gaussian = stream_in);
+	return result;
+}
+
+component Token<uint10> transpose_6x8(uint10 stream_in) {
+	static ReorderBuffer<uint10,6,8,ReorderMode::transpose> buffer;
+	return (buffer = stream_in);
+}
+
+component Token<uint10> raster_to_tile_4x4(uint10 stream_in) {
+	static ReorderBuffer<uint10,8,8,ReorderMode::raster_to_tile,4,4> buffer;
+	return (buffer = stream_in);
+}
+
+component Token<uint10> tile_to_raster_4x4(uint10 stream_in) {
+	static ReorderBuffer<uint10,8,8,ReorderMode::tile_to_raster,4,4> buffer;
+	return (buffer = stream_in);
+}
+
 //component uint32_t myRTLMod(uint32_t stream_in) {
 //	return myMod(stream_in);
 //}
@@ -78,10 +129,12 @@ component Token<int10> derivation(int10 stream_in) {
 
 component Token<fixp_33_23> derivation_fixp(fixp_33_23 stream_in) {
 	static HLSVar<fixp_33_23,1,-1> input_stream;
+	HLS_RANGE_NAME(input_stream);
 	input_stream = stream_in;
 	constexpr Token<fixp_33_23> one_third {1.0/3.0,true};
 	Token<fixp_33_23> avg = (input_stream.offset(-1) + input_stream.offset(0) + input_stream.offset(+1)) * one_third;
 	static HLSVar<fixp_33_23,1,0> diff_stream;
+	HLS_RANGE_NAME(diff_stream);
 	diff_stream = avg;
 	Token<fixp_33_23> diff = diff_stream.offset(1) - diff_stream.offset(0);
 	return diff;
@@ -110,11 +163,44 @@ component uint10 triangular_smooth_adc(uint10 stream_in)
 	return result;
 }
 
+component uint10 triangular_smooth_stencil_adc(uint10 stream_in)
+{
+	static HLSVar<uint14,3,-3> stream;
+	stream = stream_in;
+	uint10 result = triangular_smooth_stencil{}(stream).value;
+	return result;
+}
+
+component Token<uint14> triangular_smooth_folded(Token<uint10> stream_in)
+{
+	static FoldedStencil<uint10,3,-3,uint3,uint14,TRIANGULAR_FOLD> smoother {{1,2,3,4,3,2,1}};
+	Token<uint14> smoothed = (smoother = stream_in);
+	return smoothed;
+}
+
 component int11 peak_finder_adc(uint10 stream_in)
 {
 	static HLSVar<uint14,3,-3> triangular_stream_buffer;
+	HLS_RANGE_NAME(triangular_stream_buffer);
 	triangular_stream_buffer = stream_in;
 	static HLSVar<uint14,1,-1> smoothed_stream;
+	HLS_RANGE_NAME(smoothed_stream);
+	smoothed_stream = (triangular_stream_buffer.offset(-3) + Token<uint14>(2)*triangular_stream_buffer.offset(-2)
+			+ Token<uint14>(3)*triangular_stream_buffer.offset(-1) + Token<uint14>(4)*triangular_stream_buffer.offset(0)
+			+ Token<uint14>(3)*triangular_stream_buffer.offset(+1) + Token<uint14>(2)*triangular_stream_buffer.offset(+2)
+			+ triangular_stream_buffer.offset(+3))/Token<uint14>(16);
+	static HLSVar<int11> derivative;
+	HLS_RANGE_NAME(derivative);
+	derivative = ( smoothed_stream.offset(-1) - smoothed_stream.offset(1) ) / Token<int2>(2);
+	int11 result = derivative.offset(0).value;
+	return result;
+}
+
+component int11 peak_finder_delay_line_adc(uint10 stream_in)
+{
+	static HLSVar<uint14,3,-3> triangular_stream_buffer;
+	triangular_stream_buffer = stream_in;
+	static HLSDelayLine<uint14,1,-1> smoothed_stream;
 	smoothed_stream = (triangular_stream_buffer.offset(-3) + Token<uint14>(2)*triangular_stream_buffer.offset(-2)
 			+ Token<uint14>(3)*triangular_stream_buffer.offset(-1) + Token<uint14>(4)*triangular_stream_buffer.offset(0)
 			+ Token<uint14>(3)*triangular_stream_buffer.offset(+1) + Token<uint14>(2)*triangular_stream_buffer.offset(+2)
@@ -125,6 +211,64 @@ component int11 peak_finder_adc(uint10 stream_in)
 	return result;
 }
 
+component int12 pair_sum_difference_adc(uint10 stream_in)
+{
+	static HLSVar<int12,1,-2> stream;
+	stream = stream_in;
+	auto pair_sum = make_hls_expr([](int k) { return stream.offset(k) + stream.offset(k-1); });
+	int12 result = (pair_sum.offset(1) - pair_sum.offset(-1)).value;
+	return result;
+}
+
+component Token<uint10> median_filter_adc(uint10 stream_in)
+{
+	static HLSVar<uint10,2,-2> stream;
+	stream = stream_in;
+	Token<uint10> result = median(stream);
+	return result;
+}
+
+component Token<uint10> sliding_median_adc(uint10 stream_in)
+{
+	static SlidingRankOrder<uint10,15> window;
+	window = stream_in;
+	Token<uint10> result = window.median();
+	return result;
+}
+
+hls_avalon_slave_component
+component Token<int20> reloadable_fir(int10 stream_in,
+		hls_avalon_slave_memory_argument(3*sizeof(int8)) int8 *coefficients,
+		hls_avalon_slave_register_argument bool coefficient_reload,
+		bool stream_boundary)
+{
+	static HLSVar<int10,1,-1> stream;
+	stream = stream_in;
+	static CoefficientBank<int8,3> bank {{1,1,1}};
+	bank.update(coefficients,coefficient_reload,stream_boundary);
+	Token<int20> result = bank.apply<int20>(stream);
+	return result;
+}
+
+component Token<fixp_24_4> lms_adaptive_fir(fixp_24_4 stream_in, fixp_24_4 desired_in)
+{
+	static HLSVar<fixp_24_4,2,0> stream;
+	stream = stream_in;
+	static CoefficientBank<fixp_24_4,3> bank;
+	Token<fixp_24_4> filtered = bank.apply<fixp_24_4>(stream);
+	Token<fixp_24_4> error = Token<fixp_24_4>(desired_in) - filtered;
+	constexpr fixp_24_4 step {1.0/16.0};
+	bank.adapt(stream,error,step);
+	return filtered;
+}
+
+component Token<int24> matched_filter_systolic(int10 stream_in)
+{
+	static SystolicFIR<int10,MATCHED_TAPS/2-1,-MATCHED_TAPS/2,int8,int24,MATCHED_FANOUT> matched_filter {matched_filter_coefficients};
+	Token<int24> filtered = (matched_filter = stream_in);
+	return filtered;
+}
+
 component Token<int> d_convol_comp(int psi_in, int u_in)
 {
         constexpr int N = 3;
@@ -137,15 +281,10 @@ component Token<int> d_convol_comp(int psi_in, int u_in)
         static HLSVar<int,N> u_stream_buffer;
         u_stream_buffer = u_in;
 
-        static HLSVar<int> psi_multiplexer_out;
-        if (psi_input_stream_counter < (N*(N-1))) {
-                psi_multiplexer_out = psi_stream_buffer.offset(N);
-        } else {
-                psi_multiplexer_out = psi_stream_buffer.offset(-N*(N-1));
-        }
+        Token<int> psi_multiplexer_out = select(psi_input_stream_counter < (N*(N-1)), psi_stream_buffer.offset(N), psi_stream_buffer.offset(-N*(N-1)));
 
         static HLSVar<int> matrics_vector_prod;
-        matrics_vector_prod = psi_multiplexer_out * u_stream_buffer;
+        matrics_vector_prod = psi_multiplexer_out * u_stream_buffer.offset(0);
 
         static HLSVar<int> result_buffer;
         result_buffer = psi_stream_buffer + matrics_vector_prod;
@@ -162,6 +301,14 @@ component Token<int> d_convol_comp(int psi_in, int u_in)
         return result;
 }
 
+component Token<uint10> round_robin_merge_adc(Token<uint10> a_in, Token<uint10> b_in)
+{
+	static Merge<uint10,2,MergePolicy::round_robin,MERGE_DEPTH> merge;
+	const Token<uint10> inputs[2] {a_in,b_in};
+	Token<uint10> merged = (merge = inputs);
+	return merged;
+}
+
 int11 peak_finder_task_function(uint10 stream_in)
 {
 	static HLSVar<uint14,3,-3> triangular_stream_buffer;
@@ -186,3 +333,41 @@ component int11 peak_finder_task_comp(uint10 stream_in)
 	return result;
 }
 
+
+component Token<fixp_20_4> envelope_magnitude(fixp_20_4 i_in, fixp_20_4 q_in)
+{
+	static HLSVar<fixp_20_4> i_stream;
+	static HLSVar<fixp_20_4> q_stream;
+	i_stream = i_in;
+	q_stream = q_in;
+	Token<fixp_20_4> magnitude = cordic_magnitude<16>(i_stream.offset(0), q_stream.offset(0));
+	return magnitude;
+}
+
+component Token<fixp_20_4> envelope_phase(fixp_20_4 i_in, fixp_20_4 q_in)
+{
+	static HLSVar<fixp_20_4> i_stream;
+	static HLSVar<fixp_20_4> q_stream;
+	i_stream = i_in;
+	q_stream = q_in;
+	Token<fixp_20_4> phase = cordic_atan2<16>(q_stream.offset(0), i_stream.offset(0));
+	return phase;
+}
+
+component Token<uint11> adc_calibration_lut(uint10 stream_in)
+{
+	static HLSVar<uint10> stream;
+	stream = stream_in;
+	const LUT<uint10,uint11,adc_calibration_curve> calibration;
+	Token<uint11> result = calibration(stream);
+	return result;
+}
+
+component Token<uint11> adc_calibration_lut_interpolated(uint10 stream_in)
+{
+	static HLSVar<uint10> stream;
+	stream = stream_in;
+	const LUT<uint10,uint11,adc_calibration_curve,6> calibration;
+	Token<uint11> result = calibration(stream);
+	return result;
+}
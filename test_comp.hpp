@@ -19,6 +19,17 @@
 #include <iostream>
 
 #include "lib/HLSVar.hpp"
+#include "lib/Cordic.hpp"
+#include "lib/LUT.hpp"
+#include "lib/HLSExpr.hpp"
+#include "lib/RankOrder.hpp"
+#include "lib/CoefficientBank.hpp"
+#include "lib/MovingWindow.hpp"
+#include "lib/HLSBlock.hpp"
+#include "lib/Separable2D.hpp"
+#include "lib/FoldedStencil.hpp"
+#include "lib/SystolicFIR.hpp"
+#include "lib/StreamRouting.hpp"
 
 component Token<float> moving_avg_float(float stream_in);
 
@@ -26,10 +37,40 @@ component Token<uint10> moving_avg(uint10 stream_in);
 
 component uint10 moving_avg_hls (uint10 stream_in);
 
+component Token<uint10> moving_avg_long(uint10 stream_in);
+
+component Token<uint20> moving_variance_long(uint10 stream_in);
+
+using fixp_40_16 = ac_fixed<40,16,true>;
+component Token<fixp_40_16> moving_avg_float_long(float stream_in);
+
+component Token<uint10> cic_smoother_adc(uint10 stream_in);
+
 component uint10 moving_avg_RTLMod(uint10 stream_in);
 
 component uint10 convol2d(uint10 stream_in);
 
+// binomial 1-4-6-4-1 kernel, the separable 5x5 Gaussian
+struct binomial5_kernel {
+	static constexpr int radius {2};
+	template<typename W>
+	Token<uint14> operator()(const W & stream) const {
+		Token<uint14> sum = stream.offset(-2) + Token<uint14>(4)*stream.offset(-1) + Token<uint14>(6)*stream.offset(0)
+				+ Token<uint14>(4)*stream.offset(1) + stream.offset(2);
+		return {sum.value >> 4, sum.valid};
+	}
+};
+
+constexpr int GAUSS_ROWS {6};
+constexpr int GAUSS_COLS {8};
+component Token<uint10> gaussian5x5_separable(uint10 stream_in);
+
+component Token<uint10> transpose_6x8(uint10 stream_in);
+
+component Token<uint10> raster_to_tile_4x4(uint10 stream_in);
+
+component Token<uint10> tile_to_raster_4x4(uint10 stream_in);
+
 //component uint32_t myRTLMod(uint32_t stream_in);
 
 component Token<int10> derivation(int10 stream_in);
@@ -41,11 +82,67 @@ component float triangular_smooth_float(float stream_in);
 
 component uint10 triangular_smooth_adc(uint10 stream_in);
 
+// stencil shared by the component and the host block processing
+struct triangular_smooth_stencil {
+	template<typename W>
+	Token<uint14> operator()(const W & stream) const {
+		Token<uint14> smoothed = stream.offset(-3) + Token<uint14>(2)*stream.offset(-2) + Token<uint14>(3)*stream.offset(-1)
+				+ Token<uint14>(4)*stream.offset(0)
+				+ Token<uint14>(3)*stream.offset(+1) + Token<uint14>(2)*stream.offset(+2) + stream.offset(+3);
+		return {smoothed.value >> 4, smoothed.valid};
+	}
+};
+
+component uint10 triangular_smooth_stencil_adc(uint10 stream_in);
+
+constexpr int TRIANGULAR_FOLD {4};
+component Token<uint14> triangular_smooth_folded(Token<uint10> stream_in);
+
 component int11 peak_finder_adc(uint10 stream_in);
 
+component int11 peak_finder_delay_line_adc(uint10 stream_in);
+component int12 pair_sum_difference_adc(uint10 stream_in);
+
+component Token<uint10> median_filter_adc(uint10 stream_in);
+
+component Token<uint10> sliding_median_adc(uint10 stream_in);
+
+hls_avalon_slave_component
+component Token<int20> reloadable_fir(int10 stream_in,
+		hls_avalon_slave_memory_argument(3*sizeof(int8)) int8 *coefficients,
+		hls_avalon_slave_register_argument bool coefficient_reload,
+		bool stream_boundary);
+
+using fixp_24_4 = ac_fixed<24,4,true>;
+component Token<fixp_24_4> lms_adaptive_fir(fixp_24_4 stream_in, fixp_24_4 desired_in);
+
+constexpr int MATCHED_TAPS {64};
+constexpr int MATCHED_FANOUT {8};
+constexpr int matched_filter_coefficients[MATCHED_TAPS] {0,0,0,1,3,6,10,16,23,30,39,48,56,62,64,61,51,35,13,-15,-43,-69,
+		-86,-90,-78,-48,-6,40,79,99,91,55,0,-56,-93,-95,-58,3,63,92,76,21,-44,-82,-70,-17,44,72,49,-7,-52,-54,-13,33,45,17,
+		-20,-31,-12,13,17,4,-5,-2}; // windowed chirp
+component Token<int24> matched_filter_systolic(int10 stream_in);
+
 component Token<int> d_convol_comp(int psi_in, int u_in);
 
+constexpr int MERGE_DEPTH {2};
+component Token<uint10> round_robin_merge_adc(Token<uint10> a_in, Token<uint10> b_in);
+
 component int11 peak_finder_task_comp(uint10 stream_in);
 
+using fixp_20_4 = ac_fixed<20,4,true>;
+component Token<fixp_20_4> envelope_magnitude(fixp_20_4 i_in, fixp_20_4 q_in);
+
+component Token<fixp_20_4> envelope_phase(fixp_20_4 i_in, fixp_20_4 q_in);
+
+// second order ADC calibration curve y = x + x^2/2048, evaluated at compile-time
+struct adc_calibration_curve {
+	constexpr long long operator()(long long x) const { return x + (x*x)/2048; }
+};
+
+component Token<uint11> adc_calibration_lut(uint10 stream_in);
+
+component Token<uint11> adc_calibration_lut_interpolated(uint10 stream_in);
+
 
 #endif /* TEST_COMP_HPP_ */
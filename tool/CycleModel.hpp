@@ -0,0 +1,250 @@
+// Copyright (c) 2022, Thomas Janson
+// All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef TOOL_CYCLEMODEL_HPP_
+#define TOOL_CYCLEMODEL_HPP_
+
+#include <deque>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Token.hpp"
+
+// Host-side cycle model of a component, a fast estimate of latency, throughput and
+// FIFO occupancy without co-simulation. The component function itself models the
+// token level behaviour, including the valid-bit warm-up of its HLSVar buffers, one
+// invocation per cycle. The register stages of its pipeline are derived from a
+// PipelineGraph of its nodes, the longest path of operator latencies between the
+// input and the output, plus the stages of the component interface. The interface
+// stages are calibrated once against the latency of one component in an i++ report
+// and then hold for the other components of the same target and fmax. Recurrences of
+// the graph through static state bound the initiation interval. An optional FIFO
+// with fifo_depth entries in front of the component models a task launched by
+// ihc::launch.
+struct CycleReport {
+	std::string name;
+	long first_input_cycle {-1};
+	long first_output_cycle {-1};
+	long latency {-1};          // first valid output after the first valid input in cycles
+	double initiation_interval {0.0}; // mean cycles between valid outputs in steady state
+	long outputs {0};
+	long stall_cycles {0};      // cycles the input waited for a full FIFO or a busy component
+	int max_fifo_occupancy {0};
+};
+
+inline std::ostream & operator<<(std::ostream & os, const CycleReport & report) {
+	os << std::left << std::setw(28) << report.name << std::right
+	   << std::setw(10) << report.latency
+	   << std::setw(8) << std::fixed << std::setprecision(2) << report.initiation_interval
+	   << std::setw(10) << report.outputs
+	   << std::setw(8) << report.stall_cycles
+	   << std::setw(6) << report.max_fifo_occupancy;
+	return os;
+}
+
+inline void print_cycle_reports(std::ostream & os, const std::vector<CycleReport> & reports) {
+	os << std::left << std::setw(28) << "component" << std::right
+	   << std::setw(10) << "latency" << std::setw(8) << "II" << std::setw(10) << "outputs"
+	   << std::setw(8) << "stalls" << std::setw(6) << "fifo" << std::endl;
+	for (const CycleReport & report : reports) {
+		os << report << std::endl;
+	}
+}
+
+// register stages of the operators at the target fmax, interface are the stages of
+// the component call and return, which calibrate() fits to a report
+struct OperatorLatency {
+	int add {1};
+	int mul {3};
+	int compare {1};
+	int shift {0};      // constant shifts and divisions by powers of two
+	int interface {0};
+
+	// balanced adder tree over terms inputs
+	int adder_tree(int terms) const {
+		int levels {0};
+		for (int width = 1; width < terms; width *= 2) {
+			++levels;
+		}
+		return levels * add;
+	}
+
+	// restoring divider, one stage per quotient bit
+	int divide(int quotient_bits) const {
+		return quotient_bits;
+	}
+
+	// division by a constant, a multiplication with the reciprocal and a shift
+	int constant_divide() const {
+		return mul + shift;
+	}
+};
+
+// Nodes of a component with the operator stages from their inputs to their value,
+// usually one node per HLSVar. The stage count is the longest path from an input.
+class PipelineGraph {
+private:
+	struct Node {
+		std::string name;
+		int stages;
+	};
+	std::vector<Node> nodes;
+	int initiation_interval_bound {1};
+
+public:
+
+	// input of the component, the node id
+	int input(const std::string & name) {
+		nodes.push_back({name, 0});
+		return nodes.size() - 1;
+	}
+
+	// node with operator stages after the latest of its inputs, the node id
+	int node(const std::string & name, const std::vector<int> & inputs, int operator_stages) {
+		int latest {0};
+		for (int id : inputs) {
+			latest = (nodes.at(id).stages > latest) ? nodes.at(id).stages : latest;
+		}
+		nodes.push_back({name, latest + operator_stages});
+		return nodes.size() - 1;
+	}
+
+	// loop-carried path of cycle_stages through static state, which is read again
+	// distance invocations later, e.g. an accumulator or an LMS weight update
+	void recurrence(int cycle_stages, int distance = 1) {
+		const int bound = (cycle_stages + distance - 1) / distance;
+		initiation_interval_bound = (bound > initiation_interval_bound) ? bound : initiation_interval_bound;
+	}
+
+	int stages() const {
+		int longest {0};
+		for (const Node & node : nodes) {
+			longest = (node.stages > longest) ? node.stages : longest;
+		}
+		return longest;
+	}
+
+	int stages(int id) const {
+		return nodes.at(id).stages;
+	}
+
+	int latency(const OperatorLatency & operators) const {
+		return stages() + operators.interface;
+	}
+
+	int initiation_interval() const {
+		return initiation_interval_bound;
+	}
+};
+
+// operator latencies with the interface stages fitted to the latency of the graph's
+// component in an i++ report
+inline OperatorLatency calibrate(OperatorLatency operators, const PipelineGraph & graph, int report_latency) {
+	operators.interface = report_latency - graph.stages();
+	return operators;
+}
+
+namespace cycle_model_detail {
+
+template<typename R>
+bool is_valid(const Token<R> & output) { return output.valid; }
+
+template<typename R>
+bool is_valid(const R &) { return true; }
+
+}
+
+template<typename F>
+class CycleModel {
+private:
+	std::string name;
+	F component_function;
+	int pipeline_latency;
+	int initiation_interval;
+	int fifo_depth;
+
+public:
+
+	CycleModel(const std::string & name_param, F function_param, const PipelineGraph & graph,
+			const OperatorLatency & operators, int fifo_depth_param = 0)
+		: name {name_param}, component_function {function_param}, pipeline_latency {graph.latency(operators)},
+		  initiation_interval {graph.initiation_interval()}, fifo_depth {fifo_depth_param} {};
+
+	// runs the input trace, an invalid token in the trace is a cycle without input data
+	template<typename S>
+	CycleReport run(const std::vector<Token<S>> & trace) {
+		using output_type = decltype(component_function(trace[0].value));
+		CycleReport report;
+		report.name = name;
+		std::deque<S> fifo;
+		std::deque<std::pair<long,bool>> in_flight; // cycle the output leaves the pipeline, its valid bit
+		std::size_t input_index {0};
+		long last_issue {-initiation_interval};
+		long last_output {-1};
+		for (long cycle = 0; input_index < trace.size() || !fifo.empty() || !in_flight.empty(); ++cycle) {
+			const bool ready = (cycle - last_issue) >= initiation_interval;
+			if (fifo_depth > 0 && ready && !fifo.empty()) {
+				const output_type output = component_function(fifo.front());
+				fifo.pop_front();
+				in_flight.push_back({cycle + pipeline_latency, cycle_model_detail::is_valid(output)});
+				last_issue = cycle;
+			}
+			if (input_index < trace.size()) {
+				const Token<S> & input = trace[input_index];
+				bool accepted {false};
+				if (!input.valid) {
+					++input_index;
+				} else if (fifo_depth > 0 && static_cast<int>(fifo.size()) < fifo_depth) {
+					fifo.push_back(input.value);
+					accepted = true;
+				} else if (fifo_depth == 0 && ready) {
+					const output_type output = component_function(input.value);
+					in_flight.push_back({cycle + pipeline_latency, cycle_model_detail::is_valid(output)});
+					last_issue = cycle;
+					accepted = true;
+				} else {
+					++report.stall_cycles;
+				}
+				if (accepted) {
+					++input_index;
+					if (report.first_input_cycle < 0) {
+						report.first_input_cycle = cycle;
+					}
+				}
+			}
+			if (static_cast<int>(fifo.size()) > report.max_fifo_occupancy) {
+				report.max_fifo_occupancy = fifo.size();
+			}
+			while (!in_flight.empty() && in_flight.front().first <= cycle) {
+				if (in_flight.front().second) {
+					if (report.first_output_cycle < 0) {
+						report.first_output_cycle = cycle;
+					}
+					last_output = cycle;
+					++report.outputs;
+				}
+				in_flight.pop_front();
+			}
+		}
+		if (report.first_output_cycle >= 0) {
+			report.latency = report.first_output_cycle - report.first_input_cycle;
+		}
+		if (report.outputs > 1) {
+			report.initiation_interval = static_cast<double>(last_output - report.first_output_cycle) / (report.outputs - 1);
+		}
+		return report;
+	}
+
+};
+
+template<typename F>
+CycleModel<F> make_cycle_model(const std::string & name, F function, const PipelineGraph & graph,
+		const OperatorLatency & operators, int fifo_depth = 0) {
+	return CycleModel<F>(name, function, graph, operators, fifo_depth);
+}
+
+#endif /* TOOL_CYCLEMODEL_HPP_ */
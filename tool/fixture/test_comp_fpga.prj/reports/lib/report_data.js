@@ -0,0 +1,4 @@
+var infoJSON={"name":"Info","rows":[{"name":"Project Name","data":["test_comp_fpga"]},{"name":"Target Family, Device, Board","data":["Arria 10, 10AX115U1F45I1SG"]}]};
+var summaryJSON={"performanceSummary":{"name":"Component Summary","columns":["Component Name","Type","Pipelined","Initiation Interval","Latency"],"children":[{"name":"peak_finder_adc","data":["component","Yes",1,11]},{"name":"moving_avg","data":["component","Yes",1,9]}]},"estimatedResources":{"name":"Estimated Resource Usage","columns":["Component Name","ALUTs ","FFs  ","RAMs ","DSPs ","MLABs"],"children":[{"name":"peak_finder_adc","data":[412,905,0,0,2]},{"name":"moving_avg","data":[133,310,0,0,0]}]}};
+var areaJSON='{"columns":["","ALUTs","FFs","RAMs","DSPs","MLABs","Details"],"debug_enabled":"true","name":"System","children":[{"name":"peak_finder_adc","type":"function","data":[420,911,0,0,2],"children":[{"name":"peak_finder_adc.B0","type":"basicblock","data":[380,850,0,0,2]}]},{"name":"moving_avg","type":"function","data":[140,318,0,0,0]}]}';
+var loopsJSON={"columns":["","Pipelined","II","Speculated","Bottleneck","Details"],"children":[{"name":"Component: peak_finder_adc","data":["Yes","1","0","n/a"],"children":[{"name":"peak_finder_adc.B1","data":["Yes","3","0","n/a"]}]}]};
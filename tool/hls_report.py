@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022, Thomas Janson
+# All rights reserved.
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Collects the i++ report data of the components into one performance and area table.
+
+The report data of every <component>_fpga*.prj/reports directory is read from the
+JSON files and the JavaScript data files (var name = {...};) of the HTML report. For
+each component declared in the component header, fmax, latency, II and the ALM,
+ALUT, register, DSP, M20K and MLAB usage are taken from the records named after the
+component. The values of the Quartus fit replace the estimates of the HLS compile.
+The table is written as CSV and JSON. With a baseline JSON table, the changes per
+component are printed, and a lower fmax or a higher latency, II or area is marked as
+regression.
+
+  python3 tool/hls_report.py --csv hls_report.csv --json hls_report.json
+  python3 tool/hls_report.py --json hls_report.json --baseline hls_report_baseline.json
+"""
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import sys
+
+METRICS = ["fmax_mhz", "latency", "ii", "alm", "alut", "registers", "dsp", "m20k", "mlab"]
+
+# metrics where a higher value is better, all others are better lower
+HIGHER_IS_BETTER = {"fmax_mhz"}
+
+# report keys and column titles of a metric, compared in lower case
+ALIASES = {
+	"fmax": "fmax_mhz", "fmax (mhz)": "fmax_mhz", "clock1x": "fmax_mhz", "kernel fmax": "fmax_mhz",
+	"lat": "latency", "latency": "latency", "max latency": "latency",
+	"ii": "ii", "initiation interval": "ii", "achieved ii": "ii",
+	"alm": "alm", "alms": "alm",
+	"alut": "alut", "aluts": "alut",
+	"reg": "registers", "regs": "registers", "ff": "registers", "ffs": "registers", "registers": "registers",
+	"dsp": "dsp", "dsps": "dsp", "dsp blocks": "dsp",
+	"ram": "m20k", "rams": "m20k", "m20k": "m20k", "m20ks": "m20k", "ram blocks": "m20k",
+	"mlab": "mlab", "mlabs": "mlab",
+}
+
+JS_VARIABLE = re.compile(r"var\s+(\w+)\s*=\s*")
+
+
+def data_titles(columns):
+	"""Titles of the data values of a row, without the leading title of the name column."""
+	first = str(columns[0]).strip().lower() if columns else ""
+	return columns[1:] if first == "" or first.endswith("name") else columns
+
+
+def components_of(header):
+	"""Names of the component functions declared in the header."""
+	with open(header) as f:
+		source = re.sub(r"//[^\n]*|/\*.*?\*/", "", f.read(), flags=re.S)
+	return sorted(set(re.findall(r"\bcomponent\b[^;{()]*?\b(\w+)\s*\(", source)))
+
+
+def number(value):
+	"""Leading number of a report value like 1234, "1,234" or "240.5 (45%)", else None."""
+	if isinstance(value, bool):
+		return None
+	if isinstance(value, (int, float)):
+		return value
+	if isinstance(value, str):
+		match = re.match(r"\s*(-?[\d,]*\.?\d+)", value)
+		if match:
+			text = match.group(1).replace(",", "")
+			return float(text) if "." in text else int(text)
+	return None
+
+
+def component_name(name, components):
+	"""Component of a record name like "peak_finder_adc", "Component: peak_finder_adc" or a mangled name."""
+	if not isinstance(name, str):
+		return None
+	name = re.sub(r"^\s*component\s*:?\s*", "", name.strip(), flags=re.I)
+	mangled = re.match(r"_Z(\d+)(\w+)", name)
+	if mangled:
+		name = mangled.group(2)[:int(mangled.group(1))]
+	return name if name in components else None
+
+
+def report_documents(reports_dir):
+	"""JSON documents of a reports directory, from *.json files and var assignments in *.js files."""
+	documents = []
+	for root, _, files in os.walk(reports_dir):
+		for file_name in sorted(files):
+			path = os.path.join(root, file_name)
+			if file_name.endswith(".json"):
+				try:
+					with open(path) as f:
+						documents.append(json.load(f))
+				except ValueError:
+					pass
+			elif file_name.endswith(".js"):
+				with open(path) as f:
+					text = f.read()
+				decoder = json.JSONDecoder()
+				for match in JS_VARIABLE.finditer(text):
+					try:
+						if text.startswith("'", match.end()): # var nameJSON='{...}';
+							end = text.index("'", match.end() + 1)
+							document = json.loads(text[match.end() + 1:end])
+						else:
+							document = decoder.raw_decode(text, match.end())[0]
+						documents.append(document)
+					except ValueError:
+						pass
+	return documents
+
+
+def harvest(record, columns, row, fitted):
+	"""Metrics of one record of a component, from its keys or from its data row under columns."""
+	values = [(key, value) for key, value in record.items()]
+	data = record.get("data")
+	if isinstance(data, list) and columns:
+		values += list(zip(data_titles(columns), data))
+	for key, value in values:
+		metric = ALIASES.get(str(key).strip().lower())
+		if metric and number(value) is not None:
+			if fitted:
+				row[metric] = number(value)
+			else:
+				row.setdefault(metric, number(value))
+
+
+def is_fitted(document):
+	"""Whether a document holds results of the Quartus fit."""
+	return isinstance(document, dict) and any(str(key).lower().startswith("quartus") for key in document)
+
+
+def walk(node, components, table, project_fmax, fitted, columns=None):
+	if isinstance(node, dict):
+		if isinstance(node.get("columns"), list):
+			columns = node["columns"]
+		name = node.get("name")
+		component = component_name(name, components)
+		if component:
+			harvest(node, columns, table.setdefault(component, {}), fitted)
+		elif isinstance(name, str) and "clock" in name.lower() and "mhz" in name.lower():
+			for key in ("clock1x", "fmax", "data"):
+				value = node.get(key)
+				value = value[0] if isinstance(value, list) and value else value
+				if number(value) is not None:
+					project_fmax.append(number(value))
+					break
+		for child in node.values():
+			walk(child, components, table, project_fmax, fitted, columns)
+	elif isinstance(node, list):
+		for child in node:
+			walk(child, components, table, project_fmax, fitted, columns)
+
+
+def collect(project_glob, components):
+	"""Rows of the table, one per project and component found in its report."""
+	rows = []
+	for project in sorted(glob.glob(project_glob)):
+		reports_dir = os.path.join(project, "reports")
+		if not os.path.isdir(reports_dir):
+			continue
+		table = {}
+		project_fmax = []
+		for document in sorted(report_documents(reports_dir), key=is_fitted):
+			walk(document, components, table, project_fmax, is_fitted(document))
+		for component in sorted(table):
+			row = {"project": os.path.basename(project.rstrip("/")), "component": component}
+			row.update(table[component])
+			if "fmax_mhz" not in row and project_fmax:
+				row["fmax_mhz"] = project_fmax[0] # fmax of the project clock
+			rows.append(row)
+	return rows
+
+
+def diff(rows, baseline_rows):
+	"""Changed metrics against the baseline, and whether one of them is a regression."""
+	baseline = {(row["project"], row["component"]): row for row in baseline_rows}
+	lines = []
+	regression = False
+	for row in rows:
+		old = baseline.get((row["project"], row["component"]))
+		if old is None:
+			lines.append("%s %s: new" % (row["project"], row["component"]))
+			continue
+		for metric in METRICS:
+			if metric not in row or metric not in old or row[metric] == old[metric]:
+				continue
+			worse = (row[metric] < old[metric]) if metric in HIGHER_IS_BETTER else (row[metric] > old[metric])
+			regression = regression or worse
+			lines.append("%s %s: %s %s -> %s%s" % (row["project"], row["component"], metric,
+				old[metric], row[metric], "  REGRESSION" if worse else ""))
+	current = {(row["project"], row["component"]) for row in rows}
+	for key in sorted(set(baseline) - current):
+		lines.append("%s %s: removed" % key)
+	return lines, regression
+
+
+def main():
+	parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+	parser.add_argument("--projects", default="test_comp_fpga*.prj", help="glob of the i++ project directories")
+	parser.add_argument("--header", default="test_comp.hpp", help="header declaring the components")
+	parser.add_argument("--csv", help="CSV table to write")
+	parser.add_argument("--json", help="JSON table to write")
+	parser.add_argument("--baseline", help="JSON table to compare with")
+	parser.add_argument("--fail-on-regression", action="store_true", help="exit with 1 on a regression")
+	args = parser.parse_args()
+
+	rows = collect(args.projects, components_of(args.header))
+	if not rows:
+		print("no report data of the components in %s found in %s" % (args.header, args.projects), file=sys.stderr)
+		return 1
+
+	fields = ["project", "component"] + METRICS
+	if args.csv:
+		with open(args.csv, "w", newline="") as f:
+			writer = csv.DictWriter(f, fieldnames=fields)
+			writer.writeheader()
+			writer.writerows(rows)
+	if args.json:
+		with open(args.json, "w") as f:
+			json.dump(rows, f, indent=1)
+	writer = csv.DictWriter(sys.stdout, fieldnames=fields)
+	writer.writeheader()
+	writer.writerows(rows)
+
+	if args.baseline:
+		if not os.path.exists(args.baseline):
+			print("no baseline %s" % args.baseline, file=sys.stderr)
+			return 0
+		with open(args.baseline) as f:
+			lines, regression = diff(rows, json.load(f))
+		print("\nchanges against %s:" % args.baseline)
+		print("\n".join(lines) if lines else "none")
+		if regression and args.fail_on_regression:
+			return 1
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022, Thomas Janson
+# All rights reserved.
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""Tests of hls_report.py on the report data in tool/fixture."""
+
+import os
+import unittest
+
+import hls_report
+
+TOOL_DIR = os.path.dirname(os.path.abspath(__file__))
+FIXTURE = os.path.join(TOOL_DIR, "fixture", "test_comp_fpga*.prj")
+HEADER = os.path.join(TOOL_DIR, "..", "test_comp.hpp")
+
+
+class ReportTableTest(unittest.TestCase):
+
+	def setUp(self):
+		self.rows = {row["component"]: row for row in hls_report.collect(FIXTURE, hls_report.components_of(HEADER))}
+
+	def test_peak_finder_row(self):
+		row = self.rows["peak_finder_adc"]
+		self.assertEqual(row["project"], "test_comp_fpga.prj")
+		self.assertEqual(row["ii"], 1)
+		self.assertEqual(row["latency"], 11)
+		self.assertEqual(row["m20k"], 0)
+		self.assertEqual(row["dsp"], 0)
+		self.assertEqual(row["mlab"], 2)
+
+	def test_fmax_of_the_project_clock(self):
+		# no fmax record of the component, the Quartus clock summary holds for all components
+		self.assertEqual(self.rows["peak_finder_adc"]["fmax_mhz"], 312.5)
+		self.assertEqual(self.rows["moving_avg"]["fmax_mhz"], 312.5)
+
+	def test_fit_replaces_the_estimates(self):
+		row = self.rows["peak_finder_adc"]
+		# the summary estimates 412 ALUTs and 905 FFs, the area table 420 and 911
+		self.assertEqual(row["alut"], 398)
+		self.assertEqual(row["registers"], 887)
+		self.assertEqual(row["alm"], 251.5)
+		self.assertEqual(self.rows["moving_avg"]["alm"], 87)
+
+	def test_fitted_documents_are_read_last(self):
+		documents = hls_report.report_documents(os.path.join(os.path.dirname(FIXTURE), "test_comp_fpga.prj", "reports"))
+		fitted = [hls_report.is_fitted(document) for document in sorted(documents, key=hls_report.is_fitted)]
+		self.assertEqual(fitted, sorted(fitted))
+		self.assertTrue(fitted[-1])
+		self.assertFalse(fitted[0])
+
+	def test_area_table_with_name_and_details_columns(self):
+		columns = ["", "ALUTs", "FFs", "RAMs", "DSPs", "MLABs", "Details"]
+		row = {}
+		hls_report.harvest({"name": "moving_avg", "data": [140, 318, 1, 2, 3]}, columns, row, False)
+		self.assertEqual(row, {"alut": 140, "registers": 318, "m20k": 1, "dsp": 2, "mlab": 3})
+
+	def test_loop_of_a_component_is_not_the_component(self):
+		self.assertNotIn("peak_finder_adc.B1", self.rows)
+		self.assertEqual(self.rows["peak_finder_adc"]["ii"], 1)
+
+	def test_baseline_diff(self):
+		rows = [self.rows["peak_finder_adc"]]
+		baseline = [dict(rows[0], fmax_mhz=330.0, alut=400)]
+		lines, regression = hls_report.diff(rows, baseline)
+		self.assertTrue(regression)
+		self.assertEqual(lines, [
+			"test_comp_fpga.prj peak_finder_adc: fmax_mhz 330.0 -> 312.5  REGRESSION",
+			"test_comp_fpga.prj peak_finder_adc: alut 400 -> 398"])
+
+
+if __name__ == "__main__":
+	unittest.main()